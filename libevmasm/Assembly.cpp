@@ -27,6 +27,7 @@
 #include <libevmasm/PeepholeOptimiser.h>
 #include <libevmasm/Inliner.h>
 #include <libevmasm/JumpdestRemover.h>
+#include <libevmasm/JumpThreader.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
@@ -59,11 +60,50 @@ AssemblyItem const& Assembly::append(AssemblyItem _i)
 {
 	assertThrow(m_deposit >= 0, AssemblyException, "Stack underflow.");
 	m_deposit += static_cast<int>(_i.deposit());
-	m_items.emplace_back(std::move(_i));
-	if (!m_items.back().location().isValid() && m_currentSourceLocation.isValid())
-		m_items.back().setLocation(m_currentSourceLocation);
-	m_items.back().m_modifierDepth = m_currentModifierDepth;
-	return m_items.back();
+	AssemblyItems& items = currentItems();
+	items.emplace_back(std::move(_i));
+	if (!items.back().location().isValid() && m_currentSourceLocation.isValid())
+		items.back().setLocation(m_currentSourceLocation);
+	items.back().m_modifierDepth = m_currentModifierDepth;
+	return items.back();
+}
+
+uint16_t Assembly::createFunction(uint8_t _arguments, uint8_t _returns)
+{
+	assertThrow(m_eofVersion.has_value(), AssemblyException, "Functions are only available in EOF.");
+	// The first code section holds m_items and at most 1024 code sections are allowed.
+	assertThrow(m_functions.size() < 1023, AssemblyException, "Too many functions.");
+	m_functions.push_back({_arguments, _returns, {}});
+	return static_cast<uint16_t>(m_functions.size());
+}
+
+void Assembly::beginFunction(uint16_t _functionID)
+{
+	assertThrow(!m_currentFunction, AssemblyException, "Functions cannot be nested.");
+	assertThrow(0 < _functionID && _functionID <= m_functions.size(), AssemblyException, "Invalid function ID.");
+	m_currentFunction = _functionID;
+	m_depositOutsideFunction = m_deposit;
+	m_deposit = m_functions.at(_functionID - 1u).inputs;
+}
+
+void Assembly::endFunction()
+{
+	assertThrow(m_currentFunction, AssemblyException, "Not inside a function.");
+	m_currentFunction.reset();
+	m_deposit = m_depositOutsideFunction;
+}
+
+AssemblyItem Assembly::appendFunctionCall(uint16_t _functionID)
+{
+	assertThrow(0 < _functionID && _functionID <= m_functions.size(), AssemblyException, "Invalid function ID.");
+	CodeSection const& function = m_functions.at(_functionID - 1u);
+	return append(AssemblyItem::functionCall(_functionID, function.inputs, function.outputs));
+}
+
+void Assembly::appendFunctionReturn()
+{
+	assertThrow(m_currentFunction, AssemblyException, "Return outside of a function.");
+	append(AssemblyItem::functionReturn(m_functions.at(*m_currentFunction - 1u).outputs));
 }
 
 unsigned Assembly::codeSize(unsigned subTagSize) const
@@ -180,6 +220,11 @@ AssemblyItem Assembly::createAssemblyItemFromJSON(Json::Value const& _json, std:
 
 	if (c_instructions.count(name))
 	{
+		solRequire(
+			!isEOFInstruction(c_instructions.at(name)),
+			AssemblyImportException,
+			"Importing EOF instruction '" + name + "' is not supported."
+		);
 		AssemblyItem item{c_instructions.at(name), location};
 		if (!jumpType.empty())
 		{
@@ -399,6 +444,16 @@ void Assembly::assemblyStream(
 		f.feed(i, _debugInfoSelection);
 	f.flush();
 
+	for (auto&& [index, function]: m_functions | ranges::views::enumerate)
+	{
+		_out << std::endl << _prefix << "code_section_" << index + 1 << ": ";
+		_out << "(" << static_cast<unsigned>(function.inputs) << " -> " << static_cast<unsigned>(function.outputs) << ")" << std::endl;
+		Functionalizer functionalizer(_out, _prefix, _sourceCodes, *this);
+		for (auto const& i: function.items)
+			functionalizer.feed(i, _debugInfoSelection);
+		functionalizer.flush();
+	}
+
 	if (!m_data.empty() || !m_subs.empty())
 	{
 		_out << _prefix << "stop" << std::endl;
@@ -430,50 +485,68 @@ std::string Assembly::assemblyString(
 
 Json::Value Assembly::assemblyJSON(std::map<std::string, unsigned> const& _sourceIndices, bool _includeSourceList) const
 {
-	Json::Value root;
-	root[".code"] = Json::arrayValue;
-	Json::Value& code = root[".code"];
-	for (AssemblyItem const& item: m_items)
-	{
-		int sourceIndex = -1;
-		if (item.location().sourceName)
+	auto codeJSON = [&](AssemblyItems const& _items) {
+		Json::Value code = Json::arrayValue;
+		for (AssemblyItem const& item: _items)
 		{
-			auto iter = _sourceIndices.find(*item.location().sourceName);
-			if (iter != _sourceIndices.end())
-				sourceIndex = static_cast<int>(iter->second);
+			int sourceIndex = -1;
+			if (item.location().sourceName)
+			{
+				auto iter = _sourceIndices.find(*item.location().sourceName);
+				if (iter != _sourceIndices.end())
+					sourceIndex = static_cast<int>(iter->second);
+			}
+
+			auto [name, data] = item.nameAndData(m_evmVersion);
+			Json::Value jsonItem;
+			jsonItem["name"] = name;
+			jsonItem["begin"] = item.location().start;
+			jsonItem["end"] = item.location().end;
+			if (item.m_modifierDepth != 0)
+				jsonItem["modifierDepth"] = static_cast<int>(item.m_modifierDepth);
+			std::string jumpType = item.getJumpTypeAsString();
+			if (!jumpType.empty())
+				jsonItem["jumpType"] = jumpType;
+			if (name == "PUSHLIB")
+				data = m_libraries.at(h256(data));
+			else if (name == "PUSHIMMUTABLE" || name == "ASSIGNIMMUTABLE")
+				data = m_immutables.at(h256(data));
+			if (!data.empty())
+				jsonItem["value"] = data;
+			jsonItem["source"] = sourceIndex;
+			code.append(std::move(jsonItem));
+
+			// Tags do not produce a JUMPDEST in EOF.
+			if (item.type() == AssemblyItemType::Tag && !m_eofVersion.has_value())
+			{
+				Json::Value jumpdest;
+				jumpdest["name"] = "JUMPDEST";
+				jumpdest["begin"] = item.location().start;
+				jumpdest["end"] = item.location().end;
+				jumpdest["source"] = sourceIndex;
+				if (item.m_modifierDepth != 0)
+					jumpdest["modifierDepth"] = static_cast<int>(item.m_modifierDepth);
+				code.append(std::move(jumpdest));
+			}
 		}
+		return code;
+	};
 
-		auto [name, data] = item.nameAndData(m_evmVersion);
-		Json::Value jsonItem;
-		jsonItem["name"] = name;
-		jsonItem["begin"] = item.location().start;
-		jsonItem["end"] = item.location().end;
-		if (item.m_modifierDepth != 0)
-			jsonItem["modifierDepth"] = static_cast<int>(item.m_modifierDepth);
-		std::string jumpType = item.getJumpTypeAsString();
-		if (!jumpType.empty())
-			jsonItem["jumpType"] = jumpType;
-		if (name == "PUSHLIB")
-			data = m_libraries.at(h256(data));
-		else if (name == "PUSHIMMUTABLE" || name == "ASSIGNIMMUTABLE")
-			data = m_immutables.at(h256(data));
-		if (!data.empty())
-			jsonItem["value"] = data;
-		jsonItem["source"] = sourceIndex;
-		code.append(std::move(jsonItem));
-
-		if (item.type() == AssemblyItemType::Tag)
+	Json::Value root;
+	root[".code"] = codeJSON(m_items);
+	if (!m_functions.empty())
+	{
+		root[".functions"] = Json::arrayValue;
+		for (CodeSection const& function: m_functions)
 		{
-			Json::Value jumpdest;
-			jumpdest["name"] = "JUMPDEST";
-			jumpdest["begin"] = item.location().start;
-			jumpdest["end"] = item.location().end;
-			jumpdest["source"] = sourceIndex;
-			if (item.m_modifierDepth != 0)
-				jumpdest["modifierDepth"] = static_cast<int>(item.m_modifierDepth);
-			code.append(std::move(jumpdest));
+			Json::Value jsonFunction;
+			jsonFunction["inputs"] = static_cast<unsigned>(function.inputs);
+			jsonFunction["outputs"] = static_cast<unsigned>(function.outputs);
+			jsonFunction[".code"] = codeJSON(function.items);
+			root[".functions"].append(std::move(jsonFunction));
 		}
 	}
+
 	if (_includeSourceList)
 	{
 		root["sourceList"] = Json::arrayValue;
@@ -531,7 +604,7 @@ std::pair<std::shared_ptr<Assembly>, std::vector<std::string>> Assembly::fromJSO
 			"Member 'sourceList' may only be present in the root JSON object."
 		);
 
-	auto result = std::make_shared<Assembly>(EVMVersion{}, _level == 0 /* _creation */, "" /* _name */);
+	auto result = std::make_shared<Assembly>(EVMVersion{}, _level == 0 /* _creation */, std::nullopt /* _eofVersion */, "" /* _name */);
 	std::vector<std::string> parsedSourceList;
 	if (_json.isMember("sourceList"))
 	{
@@ -687,6 +760,13 @@ AssemblyItem Assembly::newImmutableAssignment(std::string const& _identifier)
 	return AssemblyItem{AssignImmutable, h};
 }
 
+void Assembly::setCompactJumpTags(bool _compactJumpTags)
+{
+	m_compactJumpTags = _compactJumpTags;
+	for (auto const& sub: m_subs)
+		sub->setCompactJumpTags(_compactJumpTags);
+}
+
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
 	optimiseInternal(_settings, {});
@@ -701,6 +781,16 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 	if (m_tagReplacements)
 		return *m_tagReplacements;
 
+	// The optimiser steps assume that control flow is expressed by jumps to pushed tags
+	// within a single code section, so they are not applied to EOF code yet.
+	if (m_eofVersion.has_value())
+	{
+		for (auto& sub: m_subs)
+			sub->optimiseInternal(_settings, {});
+		m_tagReplacements = std::map<u256, u256>{};
+		return *m_tagReplacements;
+	}
+
 	// Run optimisation for sub-assemblies.
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
@@ -729,6 +819,18 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 				_settings.evmVersion
 			}.optimise();
 
+		if (_settings.runJumpThreader)
+		{
+			JumpThreader jumpThreader{
+				m_items,
+				_settings.expectedExecutionsPerDeployment,
+				isCreation(),
+				_settings.evmVersion
+			};
+			if (jumpThreader.optimise())
+				count++;
+		}
+
 		if (_settings.runJumpdestRemover)
 		{
 			JumpdestRemover jumpdestOpt{m_items};
@@ -845,6 +947,10 @@ LinkerObject const& Assembly::assemble() const
 	// Otherwise ensure the object is actually clear.
 	assertThrow(m_assembledObject.linkReferences.empty(), AssemblyException, "Unexpected link references.");
 
+	if (m_eofVersion.has_value())
+		return assembleEOF();
+	assertThrow(m_functions.empty(), AssemblyException, "Functions are only available in EOF.");
+
 	LinkerObject& ret = m_assembledObject;
 
 	size_t subTagSize = 1;
@@ -885,13 +991,11 @@ LinkerObject const& Assembly::assemble() const
 		);
 
 	unsigned bytesRequiredForCode = codeSize(static_cast<unsigned>(subTagSize));
-	m_tagPositionsInBytecode = std::vector<size_t>(m_usedTags, std::numeric_limits<size_t>::max());
-	std::map<size_t, std::pair<size_t, size_t>> tagRef;
+	std::map<size_t, std::tuple<size_t, size_t, unsigned>> tagRef; ///< Position -> (sub id, tag id, width)
 	std::multimap<h256, unsigned> dataRef;
 	std::multimap<size_t, size_t> subRef;
 	std::vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
 	unsigned bytesPerTag = numberEncodingSize(bytesRequiredForCode);
-	uint8_t tagPush = static_cast<uint8_t>(pushInstruction(bytesPerTag));
 
 	unsigned bytesRequiredIncludingData = bytesRequiredForCode + 1 + static_cast<unsigned>(m_auxiliaryData.size());
 	for (auto const& sub: m_subs)
@@ -901,131 +1005,191 @@ LinkerObject const& Assembly::assemble() const
 	uint8_t dataRefPush = static_cast<uint8_t>(pushInstruction(bytesPerDataRef));
 	ret.bytecode.reserve(bytesRequiredIncludingData);
 
-	for (AssemblyItem const& i: m_items)
-	{
-		// store position of the invalid jump destination
-		if (i.type() != Tag && m_tagPositionsInBytecode[0] == std::numeric_limits<size_t>::max())
-			m_tagPositionsInBytecode[0] = ret.bytecode.size();
+	// Number of bytes used to encode each tag push, indexed by item.
+	// Without compact jump tags, all of them use the width needed for the largest code position.
+	// Otherwise, all references start out with one byte (or the width of the already known
+	// position of a tag in a sub-assembly) and references to local tags are widened below
+	// until every tag position fits.
+	std::vector<unsigned> tagPushWidths(m_items.size(), bytesPerTag);
+	if (m_compactJumpTags)
+		for (auto&& [index, item]: m_items | ranges::views::enumerate)
+			if (item.type() == PushTag)
+			{
+				auto [subId, tagId] = item.splitForeignPushTag();
+				size_t position = 0;
+				if (subId != std::numeric_limits<size_t>::max() && subId < m_subs.size())
+				{
+					std::vector<size_t> const& subTagPositions = m_subs[subId]->m_tagPositionsInBytecode;
+					if (tagId < subTagPositions.size() && subTagPositions[tagId] != std::numeric_limits<size_t>::max())
+						position = subTagPositions[tagId];
+				}
+				tagPushWidths[index] = std::max(1u, numberEncodingSize(position));
+			}
 
-		switch (i.type())
-		{
-		case Operation:
-			ret.bytecode.push_back(static_cast<uint8_t>(i.instruction()));
-			break;
-		case Push:
+	auto const immutableReferencesBeforeAssignment = immutableReferencesBySub;
+	for (bool layoutStable = false; !layoutStable;)
+	{
+		ret.bytecode.clear();
+		ret.linkReferences.clear();
+		ret.immutableReferences.clear();
+		immutableReferencesBySub = immutableReferencesBeforeAssignment;
+		m_tagPositionsInBytecode = std::vector<size_t>(m_usedTags, std::numeric_limits<size_t>::max());
+		tagRef.clear();
+		dataRef.clear();
+		subRef.clear();
+		sizeRef.clear();
+
+		for (auto&& [index, i]: m_items | ranges::views::enumerate)
 		{
-			unsigned b = numberEncodingSize(i.data());
-			if (b == 0 && !m_evmVersion.hasPush0())
+			// store position of the invalid jump destination
+			if (i.type() != Tag && m_tagPositionsInBytecode[0] == std::numeric_limits<size_t>::max())
+				m_tagPositionsInBytecode[0] = ret.bytecode.size();
+
+			switch (i.type())
+			{
+			case Operation:
+				ret.bytecode.push_back(static_cast<uint8_t>(i.instruction()));
+				break;
+			case Push:
+			{
+				unsigned b = numberEncodingSize(i.data());
+				if (b == 0 && !m_evmVersion.hasPush0())
+				{
+					b = 1;
+				}
+				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
+				if (b > 0)
+				{
+					ret.bytecode.resize(ret.bytecode.size() + b);
+					bytesRef byr(&ret.bytecode.back() + 1 - b, b);
+					toBigEndian(i.data(), byr);
+				}
+				break;
+			}
+			case PushTag:
 			{
-				b = 1;
+				unsigned width = tagPushWidths[index];
+				auto [subId, tagId] = i.splitForeignPushTag();
+				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(width)));
+				tagRef[ret.bytecode.size()] = {subId, tagId, width};
+				ret.bytecode.resize(ret.bytecode.size() + width);
+				break;
 			}
-			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
-			if (b > 0)
+			case PushData:
+				ret.bytecode.push_back(dataRefPush);
+				dataRef.insert(std::make_pair(h256(i.data()), ret.bytecode.size()));
+				ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
+				break;
+			case PushSub:
+				assertThrow(i.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
+				ret.bytecode.push_back(dataRefPush);
+				subRef.insert(std::make_pair(static_cast<size_t>(i.data()), ret.bytecode.size()));
+				ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
+				break;
+			case PushSubSize:
 			{
+				assertThrow(i.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
+				auto s = subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
+				i.setPushedValue(u256(s));
+				unsigned b = std::max<unsigned>(1, numberEncodingSize(s));
+				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
 				ret.bytecode.resize(ret.bytecode.size() + b);
 				bytesRef byr(&ret.bytecode.back() + 1 - b, b);
-				toBigEndian(i.data(), byr);
+				toBigEndian(s, byr);
+				break;
 			}
-			break;
-		}
-		case PushTag:
-		{
-			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
-			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
-			break;
-		}
-		case PushData:
-			ret.bytecode.push_back(dataRefPush);
-			dataRef.insert(std::make_pair(h256(i.data()), ret.bytecode.size()));
-			ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
-			break;
-		case PushSub:
-			assertThrow(i.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
-			ret.bytecode.push_back(dataRefPush);
-			subRef.insert(std::make_pair(static_cast<size_t>(i.data()), ret.bytecode.size()));
-			ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
-			break;
-		case PushSubSize:
-		{
-			assertThrow(i.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
-			auto s = subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
-			i.setPushedValue(u256(s));
-			unsigned b = std::max<unsigned>(1, numberEncodingSize(s));
-			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
-			ret.bytecode.resize(ret.bytecode.size() + b);
-			bytesRef byr(&ret.bytecode.back() + 1 - b, b);
-			toBigEndian(s, byr);
-			break;
-		}
-		case PushProgramSize:
-		{
-			ret.bytecode.push_back(dataRefPush);
-			sizeRef.push_back(static_cast<unsigned>(ret.bytecode.size()));
-			ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
-			break;
-		}
-		case PushLibraryAddress:
-			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH20));
-			ret.linkReferences[ret.bytecode.size()] = m_libraries.at(i.data());
-			ret.bytecode.resize(ret.bytecode.size() + 20);
-			break;
-		case PushImmutable:
-			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH32));
-			// Maps keccak back to the "identifier" std::string of that immutable.
-			ret.immutableReferences[i.data()].first = m_immutables.at(i.data());
-			// Record the bytecode offset of the PUSH32 argument.
-			ret.immutableReferences[i.data()].second.emplace_back(ret.bytecode.size());
-			// Advance bytecode by 32 bytes (default initialized).
-			ret.bytecode.resize(ret.bytecode.size() + 32);
-			break;
-		case VerbatimBytecode:
-			ret.bytecode += i.verbatimData();
-			break;
-		case AssignImmutable:
-		{
-			// Expect 2 elements on stack (source, dest_base)
-			auto const& offsets = immutableReferencesBySub[i.data()].second;
-			for (size_t i = 0; i < offsets.size(); ++i)
+			case PushProgramSize:
+			{
+				ret.bytecode.push_back(dataRefPush);
+				sizeRef.push_back(static_cast<unsigned>(ret.bytecode.size()));
+				ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
+				break;
+			}
+			case PushLibraryAddress:
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH20));
+				ret.linkReferences[ret.bytecode.size()] = m_libraries.at(i.data());
+				ret.bytecode.resize(ret.bytecode.size() + 20);
+				break;
+			case PushImmutable:
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH32));
+				// Maps keccak back to the "identifier" std::string of that immutable.
+				ret.immutableReferences[i.data()].first = m_immutables.at(i.data());
+				// Record the bytecode offset of the PUSH32 argument.
+				ret.immutableReferences[i.data()].second.emplace_back(ret.bytecode.size());
+				// Advance bytecode by 32 bytes (default initialized).
+				ret.bytecode.resize(ret.bytecode.size() + 32);
+				break;
+			case VerbatimBytecode:
+				ret.bytecode += i.verbatimData();
+				break;
+			case AssignImmutable:
 			{
-				if (i != offsets.size() - 1)
+				// Expect 2 elements on stack (source, dest_base)
+				auto const& offsets = immutableReferencesBySub[i.data()].second;
+				for (size_t i = 0; i < offsets.size(); ++i)
 				{
-					ret.bytecode.push_back(uint8_t(Instruction::DUP2));
-					ret.bytecode.push_back(uint8_t(Instruction::DUP2));
+					if (i != offsets.size() - 1)
+					{
+						ret.bytecode.push_back(uint8_t(Instruction::DUP2));
+						ret.bytecode.push_back(uint8_t(Instruction::DUP2));
+					}
+					// TODO: should we make use of the constant optimizer methods for pushing the offsets?
+					bytes offsetBytes = toCompactBigEndian(u256(offsets[i]));
+					ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(static_cast<unsigned>(offsetBytes.size()))));
+					ret.bytecode += offsetBytes;
+					ret.bytecode.push_back(uint8_t(Instruction::ADD));
+					ret.bytecode.push_back(uint8_t(Instruction::MSTORE));
 				}
-				// TODO: should we make use of the constant optimizer methods for pushing the offsets?
-				bytes offsetBytes = toCompactBigEndian(u256(offsets[i]));
-				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(static_cast<unsigned>(offsetBytes.size()))));
-				ret.bytecode += offsetBytes;
-				ret.bytecode.push_back(uint8_t(Instruction::ADD));
-				ret.bytecode.push_back(uint8_t(Instruction::MSTORE));
+				if (offsets.empty())
+				{
+					ret.bytecode.push_back(uint8_t(Instruction::POP));
+					ret.bytecode.push_back(uint8_t(Instruction::POP));
+				}
+				immutableReferencesBySub.erase(i.data());
+				break;
 			}
-			if (offsets.empty())
+			case PushDeployTimeAddress:
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH20));
+				ret.bytecode.resize(ret.bytecode.size() + 20);
+				break;
+			case Tag:
 			{
-				ret.bytecode.push_back(uint8_t(Instruction::POP));
-				ret.bytecode.push_back(uint8_t(Instruction::POP));
+				assertThrow(i.data() != 0, AssemblyException, "Invalid tag position.");
+				assertThrow(i.splitForeignPushTag().first == std::numeric_limits<size_t>::max(), AssemblyException, "Foreign tag.");
+				size_t tagId = static_cast<size_t>(i.data());
+				assertThrow(ret.bytecode.size() < 0xffffffffL, AssemblyException, "Tag too large.");
+				assertThrow(m_tagPositionsInBytecode[tagId] == std::numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
+				m_tagPositionsInBytecode[tagId] = ret.bytecode.size();
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::JUMPDEST));
+				break;
+			}
+			default:
+				assertThrow(false, InvalidOpcode, "Unexpected opcode while assembling.");
 			}
-			immutableReferencesBySub.erase(i.data());
-			break;
 		}
-		case PushDeployTimeAddress:
-			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH20));
-			ret.bytecode.resize(ret.bytecode.size() + 20);
-			break;
-		case Tag:
-		{
-			assertThrow(i.data() != 0, AssemblyException, "Invalid tag position.");
-			assertThrow(i.splitForeignPushTag().first == std::numeric_limits<size_t>::max(), AssemblyException, "Foreign tag.");
-			size_t tagId = static_cast<size_t>(i.data());
-			assertThrow(ret.bytecode.size() < 0xffffffffL, AssemblyException, "Tag too large.");
-			assertThrow(m_tagPositionsInBytecode[tagId] == std::numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
-			m_tagPositionsInBytecode[tagId] = ret.bytecode.size();
-			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::JUMPDEST));
+
+		if (!m_compactJumpTags)
 			break;
-		}
-		default:
-			assertThrow(false, InvalidOpcode, "Unexpected opcode while assembling.");
-		}
+
+		// Widen the references to local tags whose position does not fit and lay out
+		// the code again. Widths never shrink, so this terminates.
+		layoutStable = true;
+		for (auto&& [index, item]: m_items | ranges::views::enumerate)
+			if (item.type() == PushTag)
+			{
+				auto [subId, tagId] = item.splitForeignPushTag();
+				if (subId != std::numeric_limits<size_t>::max() || tagId >= m_tagPositionsInBytecode.size())
+					continue;
+				size_t position = m_tagPositionsInBytecode[tagId];
+				if (position == std::numeric_limits<size_t>::max())
+					continue;
+				unsigned requiredWidth = std::max(1u, numberEncodingSize(position));
+				if (requiredWidth > tagPushWidths[index])
+				{
+					tagPushWidths[index] = requiredWidth;
+					layoutStable = false;
+				}
+			}
 	}
 
 	if (!immutableReferencesBySub.empty())
@@ -1061,9 +1225,7 @@ LinkerObject const& Assembly::assemble() const
 	}
 	for (auto const& i: tagRef)
 	{
-		size_t subId;
-		size_t tagId;
-		std::tie(subId, tagId) = i.second;
+		auto [subId, tagId, width] = i.second;
 		assertThrow(subId == std::numeric_limits<size_t>::max() || subId < m_subs.size(), AssemblyException, "Invalid sub id");
 		std::vector<size_t> const& tagPositions =
 			subId == std::numeric_limits<size_t>::max() ?
@@ -1072,8 +1234,8 @@ LinkerObject const& Assembly::assemble() const
 		assertThrow(tagId < tagPositions.size(), AssemblyException, "Reference to non-existing tag.");
 		size_t pos = tagPositions[tagId];
 		assertThrow(pos != std::numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
-		assertThrow(numberEncodingSize(pos) <= bytesPerTag, AssemblyException, "Tag too large for reserved space.");
-		bytesRef r(ret.bytecode.data() + i.first, bytesPerTag);
+		assertThrow(numberEncodingSize(pos) <= width, AssemblyException, "Tag too large for reserved space.");
+		bytesRef r(ret.bytecode.data() + i.first, width);
 		toBigEndian(pos, r);
 	}
 	for (auto const& [name, tagInfo]: m_namedTags)
@@ -1118,6 +1280,406 @@ LinkerObject const& Assembly::assemble() const
 	return ret;
 }
 
+namespace
+{
+
+void appendUint16(bytes& _out, size_t _value)
+{
+	assertThrow(_value <= 0xffff, AssemblyException, "Value does not fit into 16 bits.");
+	_out.push_back(static_cast<uint8_t>(_value >> 8));
+	_out.push_back(static_cast<uint8_t>(_value & 0xff));
+}
+
+/// @returns the maximum stack height reached by the EOF code section @a _code, which starts
+/// with @a _inputs items on the stack, as required by the type section of the container.
+/// @a _types contains the number of inputs and outputs of each code section of the container.
+size_t maxStackHeight(
+	bytesConstRef _code,
+	uint8_t _inputs,
+	std::vector<std::pair<uint8_t, uint8_t>> const& _types,
+	EVMVersion _evmVersion
+)
+{
+	assertThrow(!_code.empty(), AssemblyException, "Empty code section.");
+	// Stack height before executing the instruction at each position, if the position was reached.
+	std::vector<std::optional<size_t>> heights(_code.size());
+	std::vector<size_t> toVisit;
+	auto reach = [&](size_t _position, size_t _height) {
+		assertThrow(_position < _code.size(), AssemblyException, "Control flow leaves the code section.");
+		if (heights[_position])
+			assertThrow(*heights[_position] == _height, AssemblyException, "Inconsistent stack height.");
+		else
+		{
+			heights[_position] = _height;
+			toVisit.push_back(_position);
+		}
+	};
+
+	size_t maxHeight = _inputs;
+	reach(0, _inputs);
+	while (!toVisit.empty())
+	{
+		size_t position = toVisit.back();
+		toVisit.pop_back();
+		auto instruction = static_cast<Instruction>(_code[position]);
+		InstructionInfo info = instructionInfo(instruction, _evmVersion);
+		size_t next = position + 1 + static_cast<size_t>(info.additional);
+		assertThrow(next <= _code.size(), AssemblyException, "Truncated immediate.");
+
+		size_t arguments = static_cast<size_t>(info.args);
+		size_t returns = static_cast<size_t>(info.ret);
+		int16_t relativeOffset = 0;
+		if (instruction == Instruction::CALLF)
+		{
+			size_t section = (size_t(_code[position + 1]) << 8) | _code[position + 2];
+			std::tie(arguments, returns) = _types.at(section);
+		}
+		else if (instruction == Instruction::RJUMP || instruction == Instruction::RJUMPI)
+			relativeOffset = static_cast<int16_t>((uint16_t(_code[position + 1]) << 8) | _code[position + 2]);
+
+		size_t height = *heights[position];
+		assertThrow(height >= arguments, AssemblyException, "Stack underflow.");
+		height = height - arguments + returns;
+		maxHeight = std::max(maxHeight, height);
+
+		switch (instruction)
+		{
+		case Instruction::RJUMP:
+			reach(static_cast<size_t>(static_cast<std::ptrdiff_t>(next) + relativeOffset), height);
+			break;
+		case Instruction::RJUMPI:
+			reach(static_cast<size_t>(static_cast<std::ptrdiff_t>(next) + relativeOffset), height);
+			reach(next, height);
+			break;
+		case Instruction::STOP:
+		case Instruction::RETURN:
+		case Instruction::REVERT:
+		case Instruction::INVALID:
+		case Instruction::SELFDESTRUCT:
+		case Instruction::RETF:
+			break;
+		default:
+			reach(next, height);
+			break;
+		}
+	}
+	return maxHeight;
+}
+
+}
+
+LinkerObject const& Assembly::assembleEOF() const
+{
+	assertThrow(*m_eofVersion == 1, AssemblyException, "Unsupported EOF version.");
+	assertThrow(!m_currentFunction, AssemblyException, "Unfinished function.");
+	LinkerObject& ret = m_assembledObject;
+
+	std::map<u256, std::pair<std::string, std::vector<size_t>>> immutableReferencesBySub;
+	for (auto const& sub: m_subs)
+	{
+		auto const& linkerObject = sub->assemble();
+		if (!linkerObject.immutableReferences.empty())
+		{
+			assertThrow(
+				immutableReferencesBySub.empty(),
+				AssemblyException,
+				"More than one sub-assembly references immutables."
+			);
+			immutableReferencesBySub = linkerObject.immutableReferences;
+		}
+	}
+
+	// The first code section holds the main code, the following ones hold the functions.
+	std::vector<AssemblyItems const*> codeSections{&m_items};
+	std::vector<std::pair<uint8_t, uint8_t>> types{{0, 0}};
+	for (CodeSection const& function: m_functions)
+	{
+		codeSections.push_back(&function.items);
+		types.emplace_back(function.inputs, function.outputs);
+	}
+
+	bool setsImmutables = false;
+	bool pushesImmutables = false;
+	for (AssemblyItems const* items: codeSections)
+		for (auto const& i: *items)
+			if (i.type() == AssignImmutable)
+			{
+				i.setImmutableOccurrences(immutableReferencesBySub[i.data()].second.size());
+				setsImmutables = true;
+			}
+			else if (i.type() == PushImmutable)
+				pushesImmutables = true;
+	if (setsImmutables || pushesImmutables)
+		assertThrow(
+			setsImmutables != pushesImmutables,
+			AssemblyException,
+			"Cannot push and assign immutables in the same assembly subroutine."
+		);
+
+	// Header: magic, version, type section size, code section sizes, data section size and terminator.
+	size_t const headerSize = 2 + 1 + 3 + 3 + 2 * codeSections.size() + 3 + 1;
+	size_t const typeSectionSize = 4 * codeSections.size();
+
+	// Determine the width of references into the container from an upper bound of its size.
+	unsigned bytesPerDataRef = 1;
+	for (;; ++bytesPerDataRef)
+	{
+		size_t size = headerSize + typeSectionSize + m_auxiliaryData.size();
+		for (AssemblyItems const* items: codeSections)
+			size += bytesRequired(*items, bytesPerDataRef);
+		for (auto const& sub: m_subs)
+			size += sub->assemble().bytecode.size();
+		for (auto const& dataItem: m_data)
+			size += dataItem.second.size();
+		if (numberEncodingSize(size) <= bytesPerDataRef)
+			break;
+	}
+	uint8_t dataRefPush = static_cast<uint8_t>(pushInstruction(bytesPerDataRef));
+
+	std::map<size_t, std::pair<size_t, size_t>> relativeJumpRef; ///< Position -> (tag id, code section)
+	std::multimap<h256, unsigned> dataRef;
+	std::multimap<size_t, size_t> subRef;
+	std::vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
+	std::vector<size_t> codeSectionStarts;
+	m_tagPositionsInBytecode = std::vector<size_t>(m_usedTags, std::numeric_limits<size_t>::max());
+
+	// The header and the type section are filled in once all section sizes are known.
+	ret.bytecode.assign(headerSize + typeSectionSize, 0);
+	for (auto&& [sectionIndex, items]: codeSections | ranges::views::enumerate)
+	{
+		codeSectionStarts.push_back(ret.bytecode.size());
+		for (AssemblyItem const& i: *items)
+			switch (i.type())
+			{
+			case Operation:
+				ret.bytecode.push_back(static_cast<uint8_t>(i.instruction()));
+				break;
+			case Push:
+			{
+				unsigned b = numberEncodingSize(i.data());
+				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
+				if (b > 0)
+				{
+					ret.bytecode.resize(ret.bytecode.size() + b);
+					bytesRef byr(&ret.bytecode.back() + 1 - b, b);
+					toBigEndian(i.data(), byr);
+				}
+				break;
+			}
+			case PushData:
+				ret.bytecode.push_back(dataRefPush);
+				dataRef.insert(std::make_pair(h256(i.data()), ret.bytecode.size()));
+				ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
+				break;
+			case PushSub:
+				assertThrow(i.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
+				ret.bytecode.push_back(dataRefPush);
+				subRef.insert(std::make_pair(static_cast<size_t>(i.data()), ret.bytecode.size()));
+				ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
+				break;
+			case PushSubSize:
+			{
+				assertThrow(i.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
+				auto s = subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
+				i.setPushedValue(u256(s));
+				unsigned b = std::max<unsigned>(1, numberEncodingSize(s));
+				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
+				ret.bytecode.resize(ret.bytecode.size() + b);
+				bytesRef byr(&ret.bytecode.back() + 1 - b, b);
+				toBigEndian(s, byr);
+				break;
+			}
+			case PushProgramSize:
+				ret.bytecode.push_back(dataRefPush);
+				sizeRef.push_back(static_cast<unsigned>(ret.bytecode.size()));
+				ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
+				break;
+			case PushLibraryAddress:
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH20));
+				ret.linkReferences[ret.bytecode.size()] = m_libraries.at(i.data());
+				ret.bytecode.resize(ret.bytecode.size() + 20);
+				break;
+			case PushImmutable:
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH32));
+				ret.immutableReferences[i.data()].first = m_immutables.at(i.data());
+				ret.immutableReferences[i.data()].second.emplace_back(ret.bytecode.size());
+				ret.bytecode.resize(ret.bytecode.size() + 32);
+				break;
+			case VerbatimBytecode:
+				ret.bytecode += i.verbatimData();
+				break;
+			case AssignImmutable:
+			{
+				auto const& offsets = immutableReferencesBySub[i.data()].second;
+				for (size_t offsetIndex = 0; offsetIndex < offsets.size(); ++offsetIndex)
+				{
+					if (offsetIndex != offsets.size() - 1)
+					{
+						ret.bytecode.push_back(uint8_t(Instruction::DUP2));
+						ret.bytecode.push_back(uint8_t(Instruction::DUP2));
+					}
+					bytes offsetBytes = toCompactBigEndian(u256(offsets[offsetIndex]));
+					ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(static_cast<unsigned>(offsetBytes.size()))));
+					ret.bytecode += offsetBytes;
+					ret.bytecode.push_back(uint8_t(Instruction::ADD));
+					ret.bytecode.push_back(uint8_t(Instruction::MSTORE));
+				}
+				if (offsets.empty())
+				{
+					ret.bytecode.push_back(uint8_t(Instruction::POP));
+					ret.bytecode.push_back(uint8_t(Instruction::POP));
+				}
+				immutableReferencesBySub.erase(i.data());
+				break;
+			}
+			case PushDeployTimeAddress:
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH20));
+				ret.bytecode.resize(ret.bytecode.size() + 20);
+				break;
+			case Tag:
+			{
+				// Tags are only targets of relative jumps and do not need a JUMPDEST.
+				assertThrow(i.data() != 0, AssemblyException, "Invalid tag position.");
+				assertThrow(i.splitForeignPushTag().first == std::numeric_limits<size_t>::max(), AssemblyException, "Foreign tag.");
+				size_t tagId = static_cast<size_t>(i.data());
+				assertThrow(m_tagPositionsInBytecode[tagId] == std::numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
+				m_tagPositionsInBytecode[tagId] = ret.bytecode.size();
+				break;
+			}
+			case RelativeJump:
+			case ConditionalRelativeJump:
+				ret.bytecode.push_back(static_cast<uint8_t>(
+					i.type() == RelativeJump ? Instruction::RJUMP : Instruction::RJUMPI
+				));
+				relativeJumpRef[ret.bytecode.size()] = {static_cast<size_t>(i.data()), sectionIndex};
+				ret.bytecode.resize(ret.bytecode.size() + 2);
+				break;
+			case CallF:
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::CALLF));
+				appendUint16(ret.bytecode, static_cast<size_t>(i.data()));
+				break;
+			case RetF:
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::RETF));
+				break;
+			case PushTag:
+				assertThrow(false, AssemblyException, "Jumps to pushed tags are not available in EOF.");
+				break;
+			default:
+				assertThrow(false, InvalidOpcode, "Unexpected opcode while assembling.");
+			}
+	}
+	codeSectionStarts.push_back(ret.bytecode.size());
+
+	if (!immutableReferencesBySub.empty())
+		throw
+			langutil::Error(
+				1284_error,
+				langutil::Error::Type::CodeGenerationError,
+				"Some immutables were read from but never assigned, possibly because of optimization."
+			);
+
+	for (auto const& [position, target]: relativeJumpRef)
+	{
+		auto const& [tagId, sectionIndex] = target;
+		assertThrow(tagId < m_tagPositionsInBytecode.size(), AssemblyException, "Reference to non-existing tag.");
+		size_t tagPosition = m_tagPositionsInBytecode[tagId];
+		assertThrow(
+			codeSectionStarts[sectionIndex] <= tagPosition && tagPosition < codeSectionStarts[sectionIndex + 1],
+			AssemblyException,
+			"Relative jump to a tag outside of its code section."
+		);
+		std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(tagPosition) - static_cast<std::ptrdiff_t>(position + 2);
+		assertThrow(
+			std::numeric_limits<int16_t>::min() <= offset && offset <= std::numeric_limits<int16_t>::max(),
+			AssemblyException,
+			"Relative jump too far."
+		);
+		auto encodedOffset = static_cast<uint16_t>(static_cast<int16_t>(offset));
+		ret.bytecode[position] = static_cast<uint8_t>(encodedOffset >> 8);
+		ret.bytecode[position + 1] = static_cast<uint8_t>(encodedOffset & 0xff);
+	}
+
+	// The data section holds the sub-assemblies, the referenced data and the auxiliary data,
+	// which are accessed via their offsets in the container like in legacy bytecode.
+	size_t dataSectionStart = ret.bytecode.size();
+	std::map<LinkerObject, size_t> subAssemblyOffsets;
+	for (auto const& [subIdPath, bytecodeOffset]: subRef)
+	{
+		LinkerObject subObject = subAssemblyById(subIdPath)->assemble();
+		bytesRef r(ret.bytecode.data() + bytecodeOffset, bytesPerDataRef);
+		if (size_t* subAssemblyOffset = util::valueOrNullptr(subAssemblyOffsets, subObject))
+			toBigEndian(*subAssemblyOffset, r);
+		else
+		{
+			toBigEndian(ret.bytecode.size(), r);
+			subAssemblyOffsets[subObject] = ret.bytecode.size();
+			ret.bytecode += subObject.bytecode;
+		}
+		for (auto const& ref: subObject.linkReferences)
+			ret.linkReferences[ref.first + subAssemblyOffsets[subObject]] = ref.second;
+	}
+	for (auto const& dataItem: m_data)
+	{
+		auto references = dataRef.equal_range(dataItem.first);
+		if (references.first == references.second)
+			continue;
+		for (auto ref = references.first; ref != references.second; ++ref)
+		{
+			bytesRef r(ret.bytecode.data() + ref->second, bytesPerDataRef);
+			toBigEndian(ret.bytecode.size(), r);
+		}
+		ret.bytecode += dataItem.second;
+	}
+	ret.bytecode += m_auxiliaryData;
+	for (unsigned pos: sizeRef)
+	{
+		bytesRef r(ret.bytecode.data() + pos, bytesPerDataRef);
+		toBigEndian(ret.bytecode.size(), r);
+	}
+
+	bytes header{0xef, 0x00, *m_eofVersion};
+	header.push_back(0x01);
+	appendUint16(header, typeSectionSize);
+	header.push_back(0x02);
+	appendUint16(header, codeSections.size());
+	for (size_t sectionIndex = 0; sectionIndex < codeSections.size(); ++sectionIndex)
+	{
+		size_t sectionSize = codeSectionStarts[sectionIndex + 1] - codeSectionStarts[sectionIndex];
+		assertThrow(sectionSize > 0, AssemblyException, "Empty code section.");
+		appendUint16(header, sectionSize);
+	}
+	header.push_back(0x03);
+	appendUint16(header, ret.bytecode.size() - dataSectionStart);
+	header.push_back(0x00);
+	for (size_t sectionIndex = 0; sectionIndex < codeSections.size(); ++sectionIndex)
+	{
+		auto const& [inputs, outputs] = types[sectionIndex];
+		header.push_back(inputs);
+		header.push_back(outputs);
+		bytesConstRef code(
+			ret.bytecode.data() + codeSectionStarts[sectionIndex],
+			codeSectionStarts[sectionIndex + 1] - codeSectionStarts[sectionIndex]
+		);
+		appendUint16(header, maxStackHeight(code, inputs, types, m_evmVersion));
+	}
+	assertThrow(header.size() == headerSize + typeSectionSize, AssemblyException, "");
+	std::copy(header.begin(), header.end(), ret.bytecode.begin());
+
+	for (auto const& [name, tagInfo]: m_namedTags)
+	{
+		size_t position = m_tagPositionsInBytecode.at(tagInfo.id);
+		ret.functionDebugData[name] = {
+			position == std::numeric_limits<size_t>::max() ? std::nullopt : std::optional<size_t>{position},
+			std::nullopt,
+			tagInfo.sourceID,
+			tagInfo.params,
+			tagInfo.returns
+		};
+	}
+
+	return ret;
+}
+
 std::vector<size_t> Assembly::decodeSubPath(size_t _subObjectId) const
 {
 	if (_subObjectId < m_subs.size())
@@ -1169,13 +1731,14 @@ Assembly const* Assembly::subAssemblyById(size_t _subId) const
 Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, false, _evmVersion, 0};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
+	asmSettings.runJumpThreader = _settings.runJumpThreader;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = _evmVersion;
 	return asmSettings;
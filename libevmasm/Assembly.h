@@ -39,6 +39,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <optional>
 #include <utility>
 
 namespace solidity::evmasm
@@ -49,7 +50,12 @@ using AssemblyPointer = std::shared_ptr<Assembly>;
 class Assembly
 {
 public:
-	Assembly(langutil::EVMVersion _evmVersion, bool _creation, std::string _name): m_evmVersion(_evmVersion), m_creation(_creation), m_name(std::move(_name)) { }
+	Assembly(langutil::EVMVersion _evmVersion, bool _creation, std::optional<uint8_t> _eofVersion, std::string _name):
+		m_evmVersion(_evmVersion),
+		m_eofVersion(_eofVersion),
+		m_creation(_creation),
+		m_name(std::move(_name))
+	{}
 
 	AssemblyItem newTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(Tag, m_usedTags++); }
 	AssemblyItem newPushTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(PushTag, m_usedTags++); }
@@ -60,6 +66,9 @@ public:
 	AssemblyItem newSub(AssemblyPointer const& _sub) { m_subs.push_back(_sub); return AssemblyItem(PushSub, m_subs.size() - 1); }
 	Assembly const& sub(size_t _sub) const { return *m_subs.at(_sub); }
 	Assembly& sub(size_t _sub) { return *m_subs.at(_sub); }
+	/// @returns the shared handle to the given sub-assembly, which allows referring to it
+	/// (and its assembled object) without copying it.
+	AssemblyPointer const& subPointer(size_t _sub) const { return m_subs.at(_sub); }
 	size_t numSubs() const { return m_subs.size(); }
 	AssemblyItem newPushSubSize(u256 const& _subId) { return AssemblyItem(PushSubSize, _subId); }
 	AssemblyItem newPushLibraryAddress(std::string const& _identifier);
@@ -88,6 +97,23 @@ public:
 	AssemblyItem appendJump(AssemblyItem const& _tag) { auto ret = append(_tag.pushTag()); append(Instruction::JUMP); return ret; }
 	AssemblyItem appendJumpI(AssemblyItem const& _tag) { auto ret = append(_tag.pushTag()); append(Instruction::JUMPI); return ret; }
 
+	/// Appends a relative jump (RJUMP) to @a _tag. Only valid in EOF.
+	AssemblyItem appendRelativeJump(AssemblyItem const& _tag) { return append(AssemblyItem::relativeJumpTo(_tag)); }
+	/// Appends a conditional relative jump (RJUMPI) to @a _tag. Only valid in EOF.
+	AssemblyItem appendConditionalRelativeJump(AssemblyItem const& _tag) { return append(AssemblyItem::conditionalRelativeJumpTo(_tag)); }
+
+	/// Creates a new EOF code section for a function taking @a _arguments and returning @a _returns
+	/// stack items and @returns its index. Only valid in EOF.
+	uint16_t createFunction(uint8_t _arguments, uint8_t _returns);
+	/// Directs all following items to the code section of the function @a _functionID
+	/// until ``endFunction`` is called.
+	void beginFunction(uint16_t _functionID);
+	void endFunction();
+	/// Appends a call (CALLF) of the function @a _functionID.
+	AssemblyItem appendFunctionCall(uint16_t _functionID);
+	/// Appends a return (RETF) from the function whose code section is currently being generated.
+	void appendFunctionReturn();
+
 	/// Adds a subroutine to the code (in the data section) and pushes its size (via a tag)
 	/// on the stack. @returns the pushsub assembly item.
 	AssemblyItem appendSubroutine(AssemblyPointer const& _assembly) { auto sub = newSub(_assembly); append(newPushSubSize(size_t(sub.data()))); return sub; }
@@ -98,12 +124,21 @@ public:
 	/// Appends @a _data literally to the very end of the bytecode.
 	void appendToAuxiliaryData(bytes const& _data) { m_auxiliaryData += _data; }
 
-	/// Returns the assembly items.
+	/// Returns the assembly items. In EOF, these are the items of the first code section.
 	AssemblyItems const& items() const { return m_items; }
 
 	/// Returns the mutable assembly items. Use with care!
 	AssemblyItems& items() { return m_items; }
 
+	/// Removes all but the first @a _numItems items and all but the first @a _numSubs sub-assemblies.
+	/// Used to discard code that was generated speculatively.
+	void truncate(size_t _numItems, size_t _numSubs)
+	{
+		assertThrow(_numItems <= m_items.size() && _numSubs <= m_subs.size(), AssemblyException, "Invalid truncation.");
+		m_items.erase(m_items.begin() + static_cast<std::ptrdiff_t>(_numItems), m_items.end());
+		m_subs.erase(m_subs.begin() + static_cast<std::ptrdiff_t>(_numSubs), m_subs.end());
+	}
+
 	int deposit() const { return m_deposit; }
 	void adjustDeposit(int _adjustment) { m_deposit += _adjustment; assertThrow(m_deposit >= 0, InvalidDeposit, ""); }
 	void setDeposit(int _deposit) { m_deposit = _deposit; assertThrow(m_deposit >= 0, InvalidDeposit, ""); }
@@ -113,6 +148,12 @@ public:
 	void setSourceLocation(langutil::SourceLocation const& _location) { m_currentSourceLocation = _location; }
 	langutil::SourceLocation const& currentSourceLocation() const { return m_currentSourceLocation; }
 	langutil::EVMVersion const& evmVersion() const { return m_evmVersion; }
+	std::optional<uint8_t> const& eofVersion() const { return m_eofVersion; }
+
+	/// Sets whether tag pushes of this assembly and all its sub-assemblies are encoded with the
+	/// smallest width that fits the position of their target, instead of using the same width
+	/// for all tag pushes. Has to be called before the assembly is assembled.
+	void setCompactJumpTags(bool _compactJumpTags);
 
 	/// Assembles the assembly into bytecode. The assembly should not be modified after this call, since the assembled version is cached.
 	LinkerObject const& assemble() const;
@@ -125,6 +166,9 @@ public:
 		bool runDeduplicate = false;
 		bool runCSE = false;
 		bool runConstantOptimiser = false;
+		/// Retarget jumps to blocks that only forward to another block and copy small blocks
+		/// that end the current control flow to the jumps leading to them.
+		bool runJumpThreader = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
@@ -184,6 +228,9 @@ protected:
 
 	unsigned codeSize(unsigned subTagSize) const;
 
+	/// Assembles the assembly into an EOF container. Called by ``assemble`` if an EOF version is set.
+	LinkerObject const& assembleEOF() const;
+
 	/// Add all assembly items from given JSON array. This function imports the items by iterating through
 	/// the code array. This method only works on clean Assembly objects that don't have any items defined yet.
 	/// @param _json JSON array that contains assembly items (e.g. json['.code'])
@@ -217,8 +264,26 @@ protected:
 		size_t returns;
 	};
 
+	/// EOF code section holding the code of a function.
+	struct CodeSection
+	{
+		uint8_t inputs = 0;
+		uint8_t outputs = 0;
+		AssemblyItems items;
+	};
+
+	/// @returns the items that ``append`` currently adds to.
+	AssemblyItems& currentItems() { return m_currentFunction ? m_functions.at(*m_currentFunction - 1u).items : m_items; }
+
 	std::map<std::string, NamedTagInfo> m_namedTags;
 	AssemblyItems m_items;
+	/// Code sections of the functions, only used in EOF. The function with ID i is stored at index i - 1,
+	/// since the first code section of the container holds m_items.
+	std::vector<CodeSection> m_functions;
+	/// The ID of the function whose code section is currently being generated, if any.
+	std::optional<uint16_t> m_currentFunction;
+	/// Stack height of the enclosing code while a function is being generated.
+	int m_depositOutsideFunction = 0;
 	std::map<util::h256, bytes> m_data;
 	/// Data that is appended to the very end of the contract.
 	bytes m_auxiliaryData;
@@ -237,8 +302,11 @@ protected:
 
 	mutable LinkerObject m_assembledObject;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
+	/// If true, tag pushes are encoded with the minimal width for their target during assembly.
+	bool m_compactJumpTags = false;
 
 	langutil::EVMVersion m_evmVersion;
+	std::optional<uint8_t> m_eofVersion;
 
 	int m_deposit = 0;
 	/// True, if the assembly contains contract creation code.
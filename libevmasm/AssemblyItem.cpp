@@ -27,6 +27,8 @@
 #include <libsolutil/FixedHash.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
+#include <charconv>
 #include <fstream>
 #include <limits>
 
@@ -102,6 +104,14 @@ std::pair<std::string, std::string> AssemblyItem::nameAndData(langutil::EVMVersi
 		return {"PUSH data", toStringInHex(data())};
 	case VerbatimBytecode:
 		return {"VERBATIM", util::toHex(verbatimData())};
+	case RelativeJump:
+		return {"RJUMP", util::toString(data())};
+	case ConditionalRelativeJump:
+		return {"RJUMPI", util::toString(data())};
+	case CallF:
+		return {"CALLF", util::toString(data())};
+	case RetF:
+		return {"RETF", ""};
 	default:
 		assertThrow(false, InvalidOpcode, "");
 	}
@@ -159,6 +169,12 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength, Precision _precision)
 	}
 	case VerbatimBytecode:
 		return std::get<2>(*m_verbatimBytecode).size();
+	case RelativeJump:
+	case ConditionalRelativeJump:
+	case CallF:
+		return 1 + 2;
+	case RetF:
+		return 1;
 	default:
 		break;
 	}
@@ -175,6 +191,12 @@ size_t AssemblyItem::arguments() const
 		return std::get<0>(*m_verbatimBytecode);
 	else if (type() == AssignImmutable)
 		return 2;
+	else if (type() == ConditionalRelativeJump)
+		return 1;
+	else if (type() == CallF)
+		return m_functionSignature->first;
+	else if (type() == RetF)
+		return static_cast<size_t>(data());
 	else
 		return 0;
 }
@@ -201,6 +223,8 @@ size_t AssemblyItem::returnValues() const
 		return 0;
 	case VerbatimBytecode:
 		return std::get<1>(*m_verbatimBytecode);
+	case CallF:
+		return m_functionSignature->second;
 	default:
 		break;
 	}
@@ -325,6 +349,18 @@ std::string AssemblyItem::toAssemblyText(Assembly const& _assembly) const
 	case VerbatimBytecode:
 		text = std::string("verbatimbytecode_") + util::toHex(std::get<2>(*m_verbatimBytecode));
 		break;
+	case RelativeJump:
+		text = std::string("rjump(tag_") + std::to_string(static_cast<size_t>(data())) + ")";
+		break;
+	case ConditionalRelativeJump:
+		text = std::string("rjumpi(tag_") + std::to_string(static_cast<size_t>(data())) + ")";
+		break;
+	case CallF:
+		text = std::string("callf(code_section_") + std::to_string(static_cast<size_t>(data())) + ")";
+		break;
+	case RetF:
+		text = std::string("retf");
+		break;
 	default:
 		assertThrow(false, InvalidOpcode, "");
 	}
@@ -394,6 +430,18 @@ std::ostream& solidity::evmasm::operator<<(std::ostream& _out, AssemblyItem cons
 	case VerbatimBytecode:
 		_out << " Verbatim " << util::toHex(_item.verbatimData());
 		break;
+	case RelativeJump:
+		_out << " RelativeJump " << _item.data();
+		break;
+	case ConditionalRelativeJump:
+		_out << " ConditionalRelativeJump " << _item.data();
+		break;
+	case CallF:
+		_out << " CallF " << _item.data();
+		break;
+	case RetF:
+		_out << " RetF";
+		break;
 	case UndefinedItem:
 		_out << " ???";
 		break;
@@ -423,51 +471,121 @@ size_t AssemblyItem::opcodeCount() const noexcept
 	}
 }
 
+namespace
+{
+
+/// Resolves the source name of a location to its index. Locations of consecutive items
+/// usually share the same source name string, so the result of the last lookup is
+/// kept and the map is only consulted when the shared string changes.
+class SourceIndexResolver
+{
+public:
+	explicit SourceIndexResolver(std::map<std::string, unsigned> const& _sourceIndicesMap):
+		m_sourceIndicesMap(_sourceIndicesMap)
+	{}
+
+	int operator()(SourceLocation const& _location)
+	{
+		if (!_location.sourceName)
+			return -1;
+		if (_location.sourceName.get() != m_lastSourceName)
+		{
+			auto it = m_sourceIndicesMap.find(*_location.sourceName);
+			m_lastSourceName = _location.sourceName.get();
+			m_lastSourceIndex = it != m_sourceIndicesMap.end() ? static_cast<int>(it->second) : -1;
+		}
+		return m_lastSourceIndex;
+	}
+
+private:
+	std::map<std::string, unsigned> const& m_sourceIndicesMap;
+	std::string const* m_lastSourceName = nullptr;
+	int m_lastSourceIndex = -1;
+};
+
+/// One entry of the source mapping as it is derived from a single assembly item.
+struct SourceMappingEntry
+{
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	char jump = 0;
+	int modifierDepth = -1;
+};
+
+SourceMappingEntry sourceMappingEntry(AssemblyItem const& _item, SourceIndexResolver& _resolveSourceIndex)
+{
+	SourceLocation const& location = _item.location();
+	SourceMappingEntry entry;
+	entry.start = location.start;
+	entry.length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
+	entry.sourceIndex = _resolveSourceIndex(location);
+	entry.jump = '-';
+	if (_item.getJumpType() == AssemblyItem::JumpType::IntoFunction)
+		entry.jump = 'i';
+	else if (_item.getJumpType() == AssemblyItem::JumpType::OutOfFunction)
+		entry.jump = 'o';
+	entry.modifierDepth = static_cast<int>(_item.m_modifierDepth);
+	return entry;
+}
+
+void appendInt(std::string& _out, int _value)
+{
+	std::array<char, std::numeric_limits<int>::digits10 + 2> buffer;
+	auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), _value);
+	solAssert(error == std::errc{});
+	_out.append(buffer.data(), end);
+}
+
+/// Appends @a _value as unsigned LEB128.
+void appendVarUInt(bytes& _out, uint64_t _value)
+{
+	do
+	{
+		uint8_t byte = _value & 0x7f;
+		_value >>= 7;
+		if (_value != 0)
+			byte |= 0x80;
+		_out.push_back(byte);
+	}
+	while (_value != 0);
+}
+
+}
+
 std::string AssemblyItem::computeSourceMapping(
 	AssemblyItems const& _items,
 	std::map<std::string, unsigned> const& _sourceIndicesMap
 )
 {
 	std::string ret;
+	// Most entries are empty or only differ in the start offset.
+	ret.reserve(_items.size() * 8);
 
-	int prevStart = -1;
-	int prevLength = -1;
-	int prevSourceIndex = -1;
-	int prevModifierDepth = -1;
-	char prevJump = 0;
+	SourceIndexResolver resolveSourceIndex(_sourceIndicesMap);
+	SourceMappingEntry prev;
 
 	for (auto const& item: _items)
 	{
 		if (!ret.empty())
 			ret += ";";
 
-		SourceLocation const& location = item.location();
-		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			(location.sourceName && _sourceIndicesMap.count(*location.sourceName)) ?
-			static_cast<int>(_sourceIndicesMap.at(*location.sourceName)) :
-			-1;
-		char jump = '-';
-		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
-			jump = 'i';
-		else if (item.getJumpType() == evmasm::AssemblyItem::JumpType::OutOfFunction)
-			jump = 'o';
-		int modifierDepth = static_cast<int>(item.m_modifierDepth);
+		SourceMappingEntry const entry = sourceMappingEntry(item, resolveSourceIndex);
 
 		unsigned components = 5;
-		if (modifierDepth == prevModifierDepth)
+		if (entry.modifierDepth == prev.modifierDepth)
 		{
 			components--;
-			if (jump == prevJump)
+			if (entry.jump == prev.jump)
 			{
 				components--;
-				if (sourceIndex == prevSourceIndex)
+				if (entry.sourceIndex == prev.sourceIndex)
 				{
 					components--;
-					if (length == prevLength)
+					if (entry.length == prev.length)
 					{
 						components--;
-						if (location.start == prevStart)
+						if (entry.start == prev.start)
 							components--;
 					}
 				}
@@ -476,28 +594,28 @@ std::string AssemblyItem::computeSourceMapping(
 
 		if (components-- > 0)
 		{
-			if (location.start != prevStart)
-				ret += std::to_string(location.start);
+			if (entry.start != prev.start)
+				appendInt(ret, entry.start);
 			if (components-- > 0)
 			{
 				ret += ':';
-				if (length != prevLength)
-					ret += std::to_string(length);
+				if (entry.length != prev.length)
+					appendInt(ret, entry.length);
 				if (components-- > 0)
 				{
 					ret += ':';
-					if (sourceIndex != prevSourceIndex)
-						ret += std::to_string(sourceIndex);
+					if (entry.sourceIndex != prev.sourceIndex)
+						appendInt(ret, entry.sourceIndex);
 					if (components-- > 0)
 					{
 						ret += ':';
-						if (jump != prevJump)
-							ret += jump;
+						if (entry.jump != prev.jump)
+							ret += entry.jump;
 						if (components-- > 0)
 						{
 							ret += ':';
-							if (modifierDepth != prevModifierDepth)
-								ret += std::to_string(modifierDepth);
+							if (entry.modifierDepth != prev.modifierDepth)
+								appendInt(ret, entry.modifierDepth);
 						}
 					}
 				}
@@ -505,13 +623,58 @@ std::string AssemblyItem::computeSourceMapping(
 		}
 
 		if (item.opcodeCount() > 1)
-			ret += std::string(item.opcodeCount() - 1, ';');
+			ret.append(item.opcodeCount() - 1, ';');
+
+		prev = entry;
+	}
+	return ret;
+}
+
+bytes AssemblyItem::computeBinarySourceMapping(
+	AssemblyItems const& _items,
+	std::map<std::string, unsigned> const& _sourceIndicesMap
+)
+{
+	bytes ret;
+	// One header byte per opcode plus, typically, a short start offset.
+	ret.reserve(_items.size() * 3);
+
+	SourceIndexResolver resolveSourceIndex(_sourceIndicesMap);
+	SourceMappingEntry prev;
+
+	for (auto const& item: _items)
+	{
+		SourceMappingEntry const entry = sourceMappingEntry(item, resolveSourceIndex);
+
+		uint8_t header = 0;
+		if (entry.start != prev.start)
+			header |= BinarySourceMappingStart;
+		if (entry.length != prev.length)
+			header |= BinarySourceMappingLength;
+		if (entry.sourceIndex != prev.sourceIndex)
+			header |= BinarySourceMappingSourceIndex;
+		if (entry.jump != prev.jump)
+			header |= BinarySourceMappingJump;
+		if (entry.modifierDepth != prev.modifierDepth)
+			header |= BinarySourceMappingModifierDepth;
+
+		ret.push_back(header);
+		// Start, length and source index are -1 if unknown, so they are stored with an offset of one.
+		if (header & BinarySourceMappingStart)
+			appendVarUInt(ret, static_cast<uint64_t>(entry.start + 1));
+		if (header & BinarySourceMappingLength)
+			appendVarUInt(ret, static_cast<uint64_t>(entry.length + 1));
+		if (header & BinarySourceMappingSourceIndex)
+			appendVarUInt(ret, static_cast<uint64_t>(entry.sourceIndex + 1));
+		if (header & BinarySourceMappingJump)
+			ret.push_back(static_cast<uint8_t>(entry.jump));
+		if (header & BinarySourceMappingModifierDepth)
+			appendVarUInt(ret, static_cast<uint64_t>(entry.modifierDepth));
+
+		if (item.opcodeCount() > 1)
+			ret.insert(ret.end(), item.opcodeCount() - 1, uint8_t(0));
 
-		prevStart = location.start;
-		prevLength = length;
-		prevSourceIndex = sourceIndex;
-		prevJump = jump;
-		prevModifierDepth = modifierDepth;
+		prev = entry;
 	}
 	return ret;
 }
@@ -50,7 +50,11 @@ enum AssemblyItemType
 	PushDeployTimeAddress, ///< Push an address to be filled at deploy time. Should not be touched by the optimizer.
 	PushImmutable, ///< Push the currently unknown value of an immutable variable. The actual value will be filled in by the constructor.
 	AssignImmutable, ///< Assigns the current value on the stack to an immutable variable. Only valid during creation code.
-	VerbatimBytecode ///< Contains data that is inserted into the bytecode code section without modification.
+	VerbatimBytecode, ///< Contains data that is inserted into the bytecode code section without modification.
+	RelativeJump, ///< Jumps to the tag given as data by an offset relative to the current position. Only valid in EOF.
+	ConditionalRelativeJump, ///< Like RelativeJump, but only jumps if the top of the stack is non-zero. Only valid in EOF.
+	CallF, ///< Calls the EOF code section whose index is given as data.
+	RetF ///< Returns from the current EOF code section to its caller.
 };
 
 enum class Precision { Precise , Approximate };
@@ -86,6 +90,37 @@ public:
 		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}}
 	{}
 
+	/// @returns a relative jump (RJUMP) to @a _tag.
+	static AssemblyItem relativeJumpTo(AssemblyItem const& _tag, langutil::SourceLocation _location = langutil::SourceLocation())
+	{
+		assertThrow(_tag.type() == Tag, util::Exception, "");
+		return AssemblyItem(RelativeJump, _tag.data(), std::move(_location));
+	}
+	/// @returns a conditional relative jump (RJUMPI) to @a _tag.
+	static AssemblyItem conditionalRelativeJumpTo(AssemblyItem const& _tag, langutil::SourceLocation _location = langutil::SourceLocation())
+	{
+		assertThrow(_tag.type() == Tag, util::Exception, "");
+		return AssemblyItem(ConditionalRelativeJump, _tag.data(), std::move(_location));
+	}
+	/// @returns a call (CALLF) of the code section @a _sectionIndex, which takes @a _arguments
+	/// stack items and returns @a _returnValues stack items.
+	static AssemblyItem functionCall(
+		uint16_t _sectionIndex,
+		uint8_t _arguments,
+		uint8_t _returnValues,
+		langutil::SourceLocation _location = langutil::SourceLocation()
+	)
+	{
+		AssemblyItem result(CallF, _sectionIndex, std::move(_location));
+		result.m_functionSignature = {_arguments, _returnValues};
+		return result;
+	}
+	/// @returns a return (RETF) from a code section that returns @a _returnValues stack items.
+	static AssemblyItem functionReturn(uint8_t _returnValues, langutil::SourceLocation _location = langutil::SourceLocation())
+	{
+		return AssemblyItem(RetF, _returnValues, std::move(_location));
+	}
+
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
 	AssemblyItem& operator=(AssemblyItem const&) = default;
@@ -152,11 +187,35 @@ public:
 	}
 	bool operator!=(Instruction _instr) const { return !operator==(_instr); }
 
+	/// @returns the compressed source mapping (`s:l:f:j:m` entries separated by `;`)
+	/// of @a _items, one entry per generated opcode.
 	static std::string computeSourceMapping(
 		AssemblyItems const& _items,
 		std::map<std::string, unsigned> const& _sourceIndicesMap
 	);
 
+	/// Flags of the header byte of an entry in the binary source mapping.
+	enum BinarySourceMappingField: uint8_t
+	{
+		BinarySourceMappingStart = 1,
+		BinarySourceMappingLength = 2,
+		BinarySourceMappingSourceIndex = 4,
+		BinarySourceMappingJump = 8,
+		BinarySourceMappingModifierDepth = 16
+	};
+
+	/// @returns the source mapping of @a _items in a binary format that carries the same
+	/// information as the one returned by computeSourceMapping().
+	/// Every opcode is described by a header byte whose bits (see BinarySourceMappingField) tell
+	/// which components differ from the previous entry, followed by the changed components in order:
+	/// start, length and source index as unsigned LEB128 of the value plus one (so that -1 is encoded as 0),
+	/// the jump type as a single character and the modifier depth as unsigned LEB128.
+	/// @note This format is not part of any compiler output yet and may still change.
+	static bytes computeBinarySourceMapping(
+		AssemblyItems const& _items,
+		std::map<std::string, unsigned> const& _sourceIndicesMap
+	);
+
 	/// @returns an upper bound for the number of bytes required by this item, assuming that
 	/// the value of a jump tag takes @a _addressLength bytes.
 	/// @param _precision Whether to return a precise count (which involves
@@ -196,6 +255,8 @@ private:
 	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
 	/// return variables and verbatim bytecode.
 	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
+	/// If m_type == CallF, this holds the number of arguments and return values of the called code section.
+	std::optional<std::pair<uint8_t, uint8_t>> m_functionSignature;
 	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
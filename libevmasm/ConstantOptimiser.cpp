@@ -208,15 +208,16 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 
 			u256 powerOfTwo = u256(1) << bits;
 			u256 upperPart = _value >> bits;
-			bigint lowerPart = _value & (powerOfTwo - 1);
-			if ((powerOfTwo - lowerPart) < lowerPart)
+			// The magnitudes involved are below 2**256, so the fixed-width s256 suffices.
+			s256 lowerPart = s256(_value & (powerOfTwo - 1));
+			if ((s256(powerOfTwo) - lowerPart) < lowerPart)
 			{
-				lowerPart = lowerPart - powerOfTwo; // make it negative
+				lowerPart = lowerPart - s256(powerOfTwo); // make it negative
 				upperPart++;
 			}
 			if (upperPart == 0)
 				continue;
-			if (abs(lowerPart) >= (powerOfTwo >> 8))
+			if (abs(lowerPart) >= s256(powerOfTwo >> 8))
 				continue;
 
 			AssemblyItems newRoutine;
@@ -290,7 +291,7 @@ bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const&
 					"Shift generated for invalid EVM version."
 				);
 				assertThrow(sp[0] <= u256(255), OptimizerException, "Invalid shift generated.");
-				sp[-1] = u256(bigint(sp[-1]) << unsigned(sp[0]));
+				sp[-1] = sp[-1] << unsigned(sp[0]);
 				break;
 			case Instruction::SHR:
 				assertThrow(
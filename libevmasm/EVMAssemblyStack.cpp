@@ -50,11 +50,15 @@ void EVMAssemblyStack::assemble()
 	solAssert(m_evmAssembly->isCreation());
 	solAssert(!m_evmRuntimeAssembly);
 
+	m_evmAssembly->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+	m_evmAssembly->setCompactJumpTags(m_optimiserSettings.compactJumpTags);
+
 	m_object = m_evmAssembly->assemble();
 	m_sourceMapping = AssemblyItem::computeSourceMapping(m_evmAssembly->items(), sourceIndices());
 	if (m_evmAssembly->numSubs() > 0)
 	{
-		m_evmRuntimeAssembly = std::make_shared<evmasm::Assembly>(m_evmAssembly->sub(0));
+		// The runtime assembly was already assembled as part of the creation assembly.
+		m_evmRuntimeAssembly = m_evmAssembly->subPointer(0);
 		solAssert(m_evmRuntimeAssembly && !m_evmRuntimeAssembly->isCreation());
 		m_runtimeSourceMapping = AssemblyItem::computeSourceMapping(m_evmRuntimeAssembly->items(), sourceIndices());
 		m_runtimeObject = m_evmRuntimeAssembly->assemble();
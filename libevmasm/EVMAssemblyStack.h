@@ -22,6 +22,8 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/LinkerObject.h>
 
+#include <libsolidity/interface/OptimiserSettings.h>
+
 #include <libsolutil/JSON.h>
 
 #include <map>
@@ -33,13 +35,23 @@ namespace solidity::evmasm
 class EVMAssemblyStack: public AbstractAssemblyStack
 {
 public:
-	explicit EVMAssemblyStack(langutil::EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+	explicit EVMAssemblyStack(
+		langutil::EVMVersion _evmVersion,
+		frontend::OptimiserSettings _optimiserSettings = frontend::OptimiserSettings::none()
+	):
+		m_evmVersion(_evmVersion),
+		m_optimiserSettings(std::move(_optimiserSettings))
+	{}
 
 	/// Runs parsing and analysis steps.
 	/// Multiple calls overwrite the previous state.
 	/// @throws AssemblyImportException, if JSON could not be validated.
 	void parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Runs the optimiser on the imported assembly and all its sub-assemblies according to the
+	/// settings given in the constructor and assembles the result.
+	/// The runtime object is assembled from the shared runtime sub-assembly, i.e. together with
+	/// the creation object.
 	void assemble();
 
 	std::string const& name() const { return m_name; }
@@ -71,6 +83,7 @@ public:
 
 private:
 	langutil::EVMVersion m_evmVersion;
+	frontend::OptimiserSettings m_optimiserSettings;
 	std::string m_name;
 	std::shared_ptr<evmasm::Assembly> m_evmAssembly;
 	std::shared_ptr<evmasm::Assembly> m_evmRuntimeAssembly;
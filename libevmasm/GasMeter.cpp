@@ -261,6 +261,8 @@ unsigned GasMeter::runGas(Instruction _instruction, langutil::EVMVersion _evmVer
 {
 	if (_instruction == Instruction::JUMPDEST)
 		return 1;
+	if (_instruction == Instruction::RJUMPI)
+		return GasCosts::rjumpiGas;
 
 	switch (instructionInfo(_instruction, _evmVersion).gasPriceTier)
 	{
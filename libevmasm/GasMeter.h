@@ -131,6 +131,8 @@ namespace GasCosts
 			return 20;
 	}
 	static unsigned const jumpdestGas = 1;
+	/// RJUMPI costs 4 gas (EIP-4200), which does not correspond to any tier.
+	static unsigned const rjumpiGas = 4;
 	static unsigned const logGas = 375;
 	static unsigned const logDataGas = 8;
 	static unsigned const logTopicGas = 375;
@@ -163,6 +163,10 @@ std::map<std::string, Instruction> const solidity::evmasm::c_instructions =
 	{ "LOG2", Instruction::LOG2 },
 	{ "LOG3", Instruction::LOG3 },
 	{ "LOG4", Instruction::LOG4 },
+	{ "RJUMP", Instruction::RJUMP },
+	{ "RJUMPI", Instruction::RJUMPI },
+	{ "CALLF", Instruction::CALLF },
+	{ "RETF", Instruction::RETF },
 	{ "CREATE", Instruction::CREATE },
 	{ "CALL", Instruction::CALL },
 	{ "CALLCODE", Instruction::CALLCODE },
@@ -312,6 +316,10 @@ static std::map<Instruction, InstructionInfo> const c_instructionInfo =
 	{ Instruction::LOG2,		{ "LOG2",			0, 4, 0, true, Tier::Special } },
 	{ Instruction::LOG3,		{ "LOG3",			0, 5, 0, true, Tier::Special } },
 	{ Instruction::LOG4,		{ "LOG4",			0, 6, 0, true, Tier::Special } },
+	{ Instruction::RJUMP,		{ "RJUMP",			2, 0, 0, true, Tier::Base } },
+	{ Instruction::RJUMPI,		{ "RJUMPI",			2, 1, 0, true, Tier::VeryLow } },
+	{ Instruction::CALLF,		{ "CALLF",			2, 0, 0, true, Tier::Low } },
+	{ Instruction::RETF,		{ "RETF",			0, 0, 0, true, Tier::VeryLow } },
 	{ Instruction::CREATE,		{ "CREATE",			0, 3, 1, true, Tier::Special } },
 	{ Instruction::CALL,		{ "CALL",			0, 7, 1, true, Tier::Special } },
 	{ Instruction::CALLCODE,	{ "CALLCODE",		0, 7, 1, true, Tier::Special } },
@@ -177,6 +177,11 @@ enum class Instruction: uint8_t
 	LOG3,				///< Makes a log entry; 3 topics.
 	LOG4,				///< Makes a log entry; 4 topics.
 
+	RJUMP = 0xe0,		///< relative jump by a signed 16-bit immediate offset (EOF only)
+	RJUMPI,				///< conditional relative jump by a signed 16-bit immediate offset (EOF only)
+	CALLF = 0xe3,		///< call the code section given by a 16-bit immediate index (EOF only)
+	RETF,				///< return from the current code section to its caller (EOF only)
+
 	CREATE = 0xf0,		///< create a new account with associated code
 	CALL,				///< message-call into an account
 	CALLCODE,			///< message-call with another account's code only
@@ -205,6 +210,21 @@ constexpr bool isCallInstruction(Instruction _inst) noexcept
 	}
 }
 
+/// @returns true if the instruction is only valid inside EOF code sections.
+constexpr bool isEOFInstruction(Instruction _inst) noexcept
+{
+	switch (_inst)
+	{
+		case Instruction::RJUMP:
+		case Instruction::RJUMPI:
+		case Instruction::CALLF:
+		case Instruction::RETF:
+			return true;
+		default:
+			return false;
+	}
+}
+
 /// @returns true if the instruction is a PUSH
 inline bool isPushInstruction(Instruction _inst)
 {
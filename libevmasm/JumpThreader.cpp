@@ -0,0 +1,220 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @file JumpThreader.cpp
+ * Retargets jumps to blocks that only forward to another block and replaces jumps
+ * to small blocks that leave the current control flow by a copy of these blocks.
+ */
+
+#include <libevmasm/JumpThreader.h>
+
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/numeric/accumulate.hpp>
+#include <range/v3/view/enumerate.hpp>
+#include <range/v3/view/slice.hpp>
+#include <range/v3/view/transform.hpp>
+
+#include <limits>
+#include <set>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+/// Blocks larger than this (in bytes) are never duplicated, independently of the expected number of executions.
+size_t constexpr maxDuplicatedBlockSize = 32;
+
+/// @returns an estimation of the runtime gas cost of the AsssemblyItems in @a _itemRange.
+template<typename RangeType>
+u256 executionCost(RangeType const& _itemRange, langutil::EVMVersion _evmVersion)
+{
+	GasMeter gasMeter{std::make_shared<KnownState>(), _evmVersion};
+	auto gasConsumption = ranges::accumulate(_itemRange | ranges::views::transform(
+		[&gasMeter](auto const& _item) { return gasMeter.estimateMax(_item, false); }
+	), GasMeter::GasConsumption());
+	if (gasConsumption.isInfinite)
+		return std::numeric_limits<u256>::max();
+	else
+		return gasConsumption.value;
+}
+/// @returns an estimation of the code size in bytes needed for the AssemblyItems in @a _itemRange.
+template<typename RangeType>
+uint64_t codeSize(RangeType const& _itemRange)
+{
+	return ranges::accumulate(_itemRange | ranges::views::transform(
+		[](auto const& _item) { return _item.bytesRequired(2, Precision::Approximate); }
+	), 0u);
+}
+/// @returns the tag id, if @a _item is a PushTag or Tag into the current subassembly, std::nullopt otherwise.
+std::optional<size_t> getLocalTag(AssemblyItem const& _item)
+{
+	if (_item.type() != PushTag && _item.type() != Tag)
+		return std::nullopt;
+	auto [subId, tag] = _item.splitForeignPushTag();
+	if (subId != std::numeric_limits<size_t>::max())
+		return std::nullopt;
+	return tag;
+}
+}
+
+void JumpThreader::determineBlocks()
+{
+	m_forwardingBlocks.clear();
+	m_duplicableBlocks.clear();
+
+	AssemblyItems const& items = m_items;
+	std::optional<size_t> lastTag;
+	for (auto&& [index, item]: items | ranges::views::enumerate)
+	{
+		if (lastTag && SemanticInformation::breaksCSEAnalysisBlock(item, false))
+		{
+			size_t const tag = *getLocalTag(items[*lastTag]);
+			ranges::span<AssemblyItem const> block = items | ranges::views::slice(*lastTag + 1, index + 1);
+
+			if (item.type() == Tag)
+			{
+				// A tag that is directly followed by another one.
+				if (block.size() == 1)
+					m_forwardingBlocks[tag] = *getLocalTag(item);
+			}
+			else if (
+				block.size() == 2 &&
+				block[0].type() == PushTag &&
+				block[1] == Instruction::JUMP &&
+				block[1].getJumpType() == AssemblyItem::JumpType::Ordinary
+			)
+			{
+				if (std::optional<size_t> target = getLocalTag(block[0]))
+					m_forwardingBlocks[tag] = *target;
+			}
+			else if (
+				item.type() == Operation &&
+				(item == Instruction::JUMP || SemanticInformation::terminatesControlFlow(item.instruction())) &&
+				// Blocks that push tags continue at a fixed location and are handled by threading.
+				// Excluding them also guarantees that duplication terminates.
+				!ranges::any_of(block, [](AssemblyItem const& _blockItem) { return _blockItem.type() == PushTag; })
+			)
+				m_duplicableBlocks[tag] = block;
+
+			lastTag.reset();
+		}
+
+		if (item.type() == Tag)
+		{
+			assertThrow(getLocalTag(item), OptimizerException, "");
+			lastTag = index;
+		}
+	}
+}
+
+size_t JumpThreader::threadedTarget(size_t _tag) const
+{
+	std::set<size_t> visited{_tag};
+	size_t target = _tag;
+	while (size_t const* next = util::valueOrNullptr(m_forwardingBlocks, target))
+	{
+		if (!visited.insert(*next).second)
+			// The blocks form an infinite loop, leave it as it is.
+			return _tag;
+		target = *next;
+	}
+	return target;
+}
+
+bool JumpThreader::shouldDuplicate(ranges::span<AssemblyItem const> _items) const
+{
+	static AssemblyItems const jumpPattern = {
+		AssemblyItem{PushTag},
+		AssemblyItem{Instruction::JUMP},
+	};
+	static AssemblyItems const executedJumpPattern = {
+		AssemblyItem{PushTag},
+		AssemblyItem{Instruction::JUMP},
+		AssemblyItem{Tag}
+	};
+
+	uint64_t const blockSize = codeSize(_items);
+	if (blockSize > maxDuplicatedBlockSize)
+		return false;
+	if (blockSize <= codeSize(jumpPattern))
+		return true;
+
+	// Each copy saves the jump into the block, but the original block has to be kept,
+	// since it might be reached from elsewhere.
+	bigint const additionalDepositCost = GasMeter::dataGas(blockSize - codeSize(jumpPattern), m_isCreation, m_evmVersion);
+	bigint const savedExecutionCost = bigint(m_runs) * bigint(executionCost(executedJumpPattern, m_evmVersion));
+	return savedExecutionCost > additionalDepositCost;
+}
+
+bool JumpThreader::optimise()
+{
+	determineBlocks();
+	if (m_forwardingBlocks.empty() && m_duplicableBlocks.empty())
+		return false;
+
+	bool changed = false;
+	AssemblyItems newItems;
+	newItems.reserve(m_items.size());
+	for (auto it = m_items.begin(); it != m_items.end(); ++it)
+	{
+		AssemblyItem const& item = *it;
+		if (next(it) != m_items.end() && item.type() == PushTag)
+		{
+			AssemblyItem const& nextItem = *next(it);
+			if (nextItem == Instruction::JUMP || nextItem == Instruction::JUMPI)
+				if (std::optional<size_t> tag = getLocalTag(item))
+				{
+					size_t const target = threadedTarget(*tag);
+					if (
+						nextItem == Instruction::JUMP &&
+						nextItem.getJumpType() == AssemblyItem::JumpType::Ordinary
+					)
+						if (auto const* block = util::valueOrNullptr(m_duplicableBlocks, target))
+							if (shouldDuplicate(*block))
+							{
+								newItems += *block;
+								changed = true;
+								// Skip the original jump.
+								++it;
+								continue;
+							}
+
+					if (target != *tag)
+					{
+						AssemblyItem threadedItem = item;
+						threadedItem.setData(target);
+						newItems.emplace_back(std::move(threadedItem));
+						changed = true;
+						continue;
+					}
+				}
+		}
+		newItems.emplace_back(item);
+	}
+
+	if (changed)
+		m_items = std::move(newItems);
+	return changed;
+}
@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @file JumpThreader.h
+ * Retargets jumps to blocks that only forward to another block and replaces jumps
+ * to small blocks that leave the current control flow by a copy of these blocks.
+ */
+#pragma once
+
+#include <libsolutil/Common.h>
+#include <libevmasm/Assembly.h>
+#include <libevmasm/AssemblyItem.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <range/v3/view/span.hpp>
+#include <map>
+#include <optional>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Optimisation stage that
+ *  - replaces ``PUSH tag_a JUMP`` and ``PUSH tag_a JUMPI`` by ``PUSH tag_b JUMP`` and ``PUSH tag_b JUMPI``,
+ *    if the block at ``tag_a`` consists of nothing but ``PUSH tag_b JUMP`` (or falls through to ``tag_b``
+ *    directly) and
+ *  - replaces ``PUSH tag JUMP`` by a copy of the block at ``tag``, if that block does not contain
+ *    further control flow, ends in a ``JUMP`` to a target from the stack or in a terminating
+ *    instruction and if the increase in code size is outweighed by the saved execution cost over
+ *    the expected number of executions.
+ *
+ * The original blocks are kept, so jumps to tags that are not pushed remain valid.
+ * Blocks that are no longer referenced are removed by the JumpdestRemover.
+ */
+class JumpThreader
+{
+public:
+	explicit JumpThreader(
+		AssemblyItems& _items,
+		size_t _runs,
+		bool _isCreation,
+		langutil::EVMVersion _evmVersion
+	):
+	m_items(_items),
+	m_runs(_runs),
+	m_isCreation(_isCreation),
+	m_evmVersion(_evmVersion)
+	{
+	}
+
+	/// @returns true if the items were modified.
+	bool optimise();
+
+private:
+	/// @returns the tag that a jump to @a _tag ends up at after following all blocks that only forward
+	/// to another block, or @a _tag itself if it is not such a block or the blocks form a cycle.
+	size_t threadedTarget(size_t _tag) const;
+	/// @returns true if the block @a _items that is jumped to should be copied to the jump site.
+	bool shouldDuplicate(ranges::span<AssemblyItem const> _items) const;
+	/// Collects the forwarding blocks and the blocks that can be duplicated.
+	void determineBlocks();
+
+	AssemblyItems& m_items;
+	size_t const m_runs = Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment;
+	bool const m_isCreation = false;
+	langutil::EVMVersion const m_evmVersion;
+
+	/// Tags of blocks that only jump or fall through to another block, mapped to the tag of that block.
+	std::map<size_t, size_t> m_forwardingBlocks;
+	/// Blocks that can be copied to a jump site, from the first item after the tag up to and
+	/// including the exit.
+	std::map<size_t, ranges::span<AssemblyItem const>> m_duplicableBlocks;
+};
+
+}
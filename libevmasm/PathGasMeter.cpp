@@ -28,11 +28,27 @@ using namespace solidity;
 using namespace solidity::evmasm;
 
 PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+	PathGasMeter(_items, tagPositions(_items), _evmVersion)
 {
-	for (size_t i = 0; i < m_items.size(); ++i)
-		if (m_items[i].type() == Tag)
-			m_tagPositions[m_items[i].data()] = i;
+}
+
+PathGasMeter::PathGasMeter(
+	AssemblyItems const& _items,
+	std::shared_ptr<TagPositions const> _tagPositions,
+	langutil::EVMVersion _evmVersion
+):
+	m_tagPositions(std::move(_tagPositions)), m_items(_items), m_evmVersion(_evmVersion)
+{
+	assertThrow(m_tagPositions, OptimizerException, "");
+}
+
+std::shared_ptr<PathGasMeter::TagPositions const> PathGasMeter::tagPositions(AssemblyItems const& _items)
+{
+	auto positions = std::make_shared<TagPositions>();
+	for (size_t i = 0; i < _items.size(); ++i)
+		if (_items[i].type() == Tag)
+			(*positions)[_items[i].data()] = i;
+	return positions;
 }
 
 GasMeter::GasConsumption PathGasMeter::estimateMax(
@@ -118,16 +134,25 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 
 		gas += meter.estimateMax(item);
 
-		for (u256 const& tag: jumpTags)
+		for (auto it = jumpTags.begin(); it != jumpTags.end(); ++it)
 		{
 			auto newPath = std::make_unique<GasPath>();
 			newPath->index = m_items.size();
-			if (m_tagPositions.count(tag))
-				newPath->index = m_tagPositions.at(tag);
+			if (m_tagPositions->count(*it))
+				newPath->index = m_tagPositions->at(*it);
 			newPath->gas = gas;
 			newPath->largestMemoryAccess = meter.largestMemoryAccess();
-			newPath->state = state->copy();
-			newPath->visitedJumpdests = path->visitedJumpdests;
+			if (branchStops && std::next(it) == jumpTags.end())
+			{
+				// The current path ends here, so the last successor can take over its state.
+				newPath->state = state;
+				newPath->visitedJumpdests = std::move(path->visitedJumpdests);
+			}
+			else
+			{
+				newPath->state = state->copy();
+				newPath->visitedJumpdests = path->visitedJumpdests;
+			}
 			queue(std::move(newPath));
 		}
 
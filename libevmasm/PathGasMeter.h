@@ -26,6 +26,7 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
 #include <set>
 #include <vector>
 #include <memory>
@@ -52,7 +53,20 @@ struct GasPath
 class PathGasMeter
 {
 public:
+	/// Map from tag id to the position of the tag in a list of assembly items.
+	using TagPositions = std::map<u256, size_t>;
+
 	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	/// Constructs the meter using tag positions computed upfront by @a tagPositions, so that
+	/// they can be shared between several meters working on the same list of items.
+	PathGasMeter(
+		AssemblyItems const& _items,
+		std::shared_ptr<TagPositions const> _tagPositions,
+		langutil::EVMVersion _evmVersion
+	);
+
+	/// @returns the positions of all tags in @a _items.
+	static std::shared_ptr<TagPositions const> tagPositions(AssemblyItems const& _items);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
@@ -78,7 +92,7 @@ private:
 	/// item per jumpdest, because of the behaviour of `queue` above.
 	std::map<size_t, std::unique_ptr<GasPath>> m_queue;
 	std::map<size_t, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
-	std::map<u256, size_t> m_tagPositions;
+	std::shared_ptr<TagPositions const> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
 };
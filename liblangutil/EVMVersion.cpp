@@ -49,6 +49,12 @@ bool EVMVersion::hasOpcode(Instruction _opcode) const
 		return hasSelfBalance();
 	case Instruction::BASEFEE:
 		return hasBaseFee();
+	case Instruction::RJUMP:
+	case Instruction::RJUMPI:
+	case Instruction::CALLF:
+	case Instruction::RETF:
+		// Only available inside EOF code sections and only emitted by the assembler.
+		return false;
 	default:
 		return true;
 	}
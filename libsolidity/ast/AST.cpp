@@ -130,15 +130,22 @@ SourceUnitAnnotation& SourceUnit::annotation() const
 std::set<SourceUnit const*> SourceUnit::referencedSourceUnits(bool _recurse, std::set<SourceUnit const*> _skipList) const
 {
 	std::set<SourceUnit const*> sourceUnits;
-	for (ImportDirective const* importDirective: filteredNodes<ImportDirective>(nodes()))
+	// The skip list is shared by the whole traversal, so that each source unit is only visited once
+	// even if it is imported along several paths.
+	std::vector<SourceUnit const*> toVisit{this};
+	while (!toVisit.empty())
 	{
-		auto const& sourceUnit = importDirective->annotation().sourceUnit;
-		if (!_skipList.count(sourceUnit))
+		SourceUnit const* current = toVisit.back();
+		toVisit.pop_back();
+		for (ImportDirective const* importDirective: filteredNodes<ImportDirective>(current->m_nodes))
 		{
-			_skipList.insert(sourceUnit);
-			sourceUnits.insert(sourceUnit);
-			if (_recurse)
-				sourceUnits += sourceUnit->referencedSourceUnits(true, _skipList);
+			auto const& sourceUnit = importDirective->annotation().sourceUnit;
+			if (_skipList.insert(sourceUnit).second)
+			{
+				sourceUnits.insert(sourceUnit);
+				if (_recurse)
+					toVisit.push_back(sourceUnit);
+			}
 		}
 	}
 	return sourceUnits;
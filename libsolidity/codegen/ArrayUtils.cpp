@@ -98,6 +98,31 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 		return;
 	}
 
+	// Calldata sources are excluded, since the utility function validates calldata
+	// elements and reverts if they are dirty, while the code below cleans them.
+	if (
+		m_context.packedStorageArrayCopy() &&
+		_sourceType.location() == DataLocation::Memory &&
+		sourceBaseType->isValueType() &&
+		sourceBaseType->category() != Type::Category::Function &&
+		targetBaseType->storageBytes() <= 16 &&
+		(*_sourceType.copyForLocation(DataLocation::Storage, _targetType.isPointer())).equals(_targetType)
+	)
+	{
+		// Assemble each target slot on the stack and store it once,
+		// instead of loading and storing the slot for every element.
+		// stack: target_ref source_ref
+		m_context << Instruction::DUP2;
+		// stack: target_ref source_ref target_ref
+		m_context.callYulFunction(
+			m_context.utilFunctions().copyArrayToStorageFunction(_sourceType, _targetType),
+			2,
+			0
+		);
+		// stack: target_ref
+		return;
+	}
+
 	// retrieve source length
 	if (_sourceType.location() != DataLocation::CallData || !_sourceType.isDynamicallySized())
 		retrieveLength(_sourceType); // otherwise, length is already there
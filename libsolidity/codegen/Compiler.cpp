@@ -48,10 +48,20 @@ void Compiler::compileContract(
 	ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
 	m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
 
+	// Reserve the memory of local variables that were moved out of the stack.
+	m_runtimeContext.finalizeSpilledVariables();
+	m_context.finalizeSpilledVariables();
+
 	m_context.optimise(m_optimiserSettings);
+	m_context.setCompactJumpTags(m_optimiserSettings.compactJumpTags);
 
 	solAssert(m_context.appendYulUtilityFunctionsRan(), "appendYulUtilityFunctions() was not called.");
 	solAssert(m_runtimeContext.appendYulUtilityFunctionsRan(), "appendYulUtilityFunctions() was not called.");
+
+	// The other compilers are only needed during code generation. Dropping the references allows
+	// their memory to be released independently of the lifetime of this compiler.
+	m_context.setOtherCompilers({});
+	m_runtimeContext.setOtherCompilers({});
 }
 
 std::shared_ptr<evmasm::Assembly> Compiler::runtimeAssemblyPtr() const
@@ -41,7 +41,10 @@ public:
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_runtimeContext(_evmVersion, _revertStrings),
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
-	{ }
+	{
+		m_runtimeContext.setPackedStorageArrayCopy(m_optimiserSettings.packedStorageArrayCopy);
+		m_context.setPackedStorageArrayCopy(m_optimiserSettings.packedStorageArrayCopy);
+	}
 
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
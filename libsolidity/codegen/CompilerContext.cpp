@@ -113,12 +113,65 @@ size_t CompilerContext::reservedMemory()
 	return reservedMemory;
 }
 
+void CompilerContext::pushInitialFreeMemoryPointer(u256 const& _value)
+{
+	m_initialFreeMemoryPointer = std::make_pair(m_asm->items().size(), _value);
+	*this << _value;
+}
+
+void CompilerContext::addSpilledVariable(VariableDeclaration const& _declaration)
+{
+	solAssert(canSpillVariables(), "Free memory pointer not yet initialised.");
+	solAssert(!m_spilledVariables.count(&_declaration), "Variable spilled twice.");
+	size_t offset = static_cast<size_t>(m_initialFreeMemoryPointer->second) + m_spilledVariablesMemory;
+	m_spilledVariables[&_declaration] = offset;
+	m_spilledVariablesMemory += 32 * _declaration.annotation().type->sizeOnStack();
+	solAssert(bigint(offset) + m_spilledVariablesMemory < bigint(1) << 63);
+}
+
+size_t CompilerContext::spilledVariableMemoryOffset(VariableDeclaration const& _declaration) const
+{
+	solAssert(m_spilledVariables.count(&_declaration), "Memory offset of unknown spilled variable queried.");
+	return m_spilledVariables.at(&_declaration);
+}
+
+void CompilerContext::finalizeSpilledVariables()
+{
+	if (m_spilledVariablesMemory == 0)
+		return;
+	solAssert(m_initialFreeMemoryPointer.has_value(), "");
+	auto&& [index, value] = *m_initialFreeMemoryPointer;
+	evmasm::AssemblyItem& item = m_asm->items().at(index);
+	solAssert(item.type() == evmasm::Push && item.data() == value, "Free memory pointer initialisation not found.");
+	item.setData(value + m_spilledVariablesMemory);
+	m_spilledVariablesMemory = 0;
+}
+
 void CompilerContext::startFunction(Declaration const& _function)
 {
 	m_functionCompilationQueue.startFunction(_function);
 	*this << functionEntryLabel(_function);
 }
 
+CompilerContext::Checkpoint CompilerContext::checkpoint() const
+{
+	return Checkpoint{
+		m_asm->items().size(),
+		m_asm->numSubs(),
+		m_asm->deposit(),
+		m_arithmetic,
+		m_localVariables
+	};
+}
+
+void CompilerContext::resetToCheckpoint(Checkpoint const& _checkpoint)
+{
+	m_asm->truncate(_checkpoint.numItems, _checkpoint.numSubs);
+	m_asm->setDeposit(_checkpoint.stackHeight);
+	m_arithmetic = _checkpoint.arithmetic;
+	m_localVariables = _checkpoint.localVariables;
+}
+
 void CompilerContext::callLowLevelFunction(
 	std::string const& _name,
 	unsigned _inArgs,
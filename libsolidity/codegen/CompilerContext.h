@@ -65,7 +65,7 @@ public:
 		RevertStrings _revertStrings,
 		CompilerContext* _runtimeContext = nullptr
 	):
-		m_asm(std::make_shared<evmasm::Assembly>(_evmVersion, _runtimeContext != nullptr, std::string{})),
+		m_asm(std::make_shared<evmasm::Assembly>(_evmVersion, _runtimeContext != nullptr, std::nullopt, std::string{})),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
@@ -82,6 +82,11 @@ public:
 	void setUseABICoderV2(bool _value) { m_useABICoderV2 = _value; }
 	bool useABICoderV2() const { return m_useABICoderV2; }
 
+	/// Sets whether arrays of small value types are copied to storage slot by slot
+	/// instead of element by element.
+	void setPackedStorageArrayCopy(bool _value) { m_packedStorageArrayCopy = _value; }
+	bool packedStorageArrayCopy() const { return m_packedStorageArrayCopy; }
+
 	void addStateVariable(VariableDeclaration const& _declaration, u256 const& _storageOffset, unsigned _byteOffset);
 	void addImmutable(VariableDeclaration const& _declaration);
 
@@ -92,6 +97,20 @@ public:
 
 	/// @returns the reserved memory and resets it to mark it as used.
 	size_t reservedMemory();
+	/// Appends code that pushes the initial value of the free memory pointer, @a _value.
+	/// The value is increased later on if memory is reserved for spilled variables.
+	void pushInitialFreeMemoryPointer(u256 const& _value);
+	/// @returns true if local variables can be moved from the stack to memory.
+	bool canSpillVariables() const { return m_initialFreeMemoryPointer.has_value(); }
+	/// Reserves memory for the local variable @a _declaration, which will then no longer
+	/// be kept on the stack.
+	void addSpilledVariable(VariableDeclaration const& _declaration);
+	bool isSpilledVariable(Declaration const* _declaration) const { return m_spilledVariables.count(_declaration) != 0; }
+	/// @returns the memory offset reserved for the spilled local variable @a _declaration.
+	size_t spilledVariableMemoryOffset(VariableDeclaration const& _declaration) const;
+	/// Adjusts the initial value of the free memory pointer to account for the memory
+	/// reserved for spilled variables. Has to be called after all code is generated.
+	void finalizeSpilledVariables();
 
 	void addVariable(VariableDeclaration const& _declaration, unsigned _offsetToCurrent = 0);
 	void removeVariable(Declaration const& _declaration);
@@ -135,6 +154,21 @@ public:
 	/// as "having code".
 	void startFunction(Declaration const& _function);
 
+	/// State of the code generation that can be restored using @a resetToCheckpoint.
+	struct Checkpoint
+	{
+		size_t numItems;
+		size_t numSubs;
+		int stackHeight;
+		Arithmetic arithmetic;
+		std::map<Declaration const*, std::vector<unsigned>> localVariables;
+	};
+	Checkpoint checkpoint() const;
+	/// Removes all code generated since @a _checkpoint and restores the stack height and
+	/// the local variables.
+	/// Functions and utilities requested in the meantime are still generated.
+	void resetToCheckpoint(Checkpoint const& _checkpoint);
+
 	/// Appends a call to the named low-level function and inserts the generator into the
 	/// list of low-level-functions to be generated, unless it already exists.
 	/// Note that the generator should not assume that objects are still alive when it is called,
@@ -284,6 +318,7 @@ public:
 
 	/// Run optimisation step.
 	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion)); }
+	void setCompactJumpTags(bool _compactJumpTags) { m_asm->setCompactJumpTags(_compactJumpTags); }
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -351,6 +386,7 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings const m_revertStrings;
 	bool m_useABICoderV2 = false;
+	bool m_packedStorageArrayCopy = false;
 	/// Other already compiled contracts to be used in contract creation calls.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> m_otherCompilers;
 	/// Storage offsets of state variables
@@ -361,6 +397,13 @@ private:
 	/// This has to be finalized before initialiseFreeMemoryPointer() is called. That function
 	/// will reset the optional to verify that.
 	std::optional<size_t> m_reservedMemory = {0};
+	/// Index of the assembly item that pushes the initial value of the free memory pointer,
+	/// together with that value.
+	std::optional<std::pair<size_t, u256>> m_initialFreeMemoryPointer;
+	/// Memory offsets of local variables that are kept in memory instead of on the stack.
+	std::map<Declaration const*, size_t> m_spilledVariables;
+	/// Amount of memory reserved for spilled local variables.
+	size_t m_spilledVariablesMemory = 0;
 	/// Offsets of local variables on the stack (relative to stack base).
 	/// This needs to be a stack because if a modifier contains a local variable and this
 	/// modifier is applied twice, the position of the variable needs to be restored
@@ -24,10 +24,12 @@
 
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTUtils.h>
+#include <libsolidity/ast/CallGraph.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolidity/codegen/ContractCompiler.h>
 #include <libsolidity/codegen/ExpressionCompiler.h>
+#include <libsolidity/codegen/LValue.h>
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmAnalysis.h>
@@ -87,6 +89,64 @@ private:
 	unsigned stackHeight;
 };
 
+/**
+ * Collects the local variables declared in a function body and the declarations
+ * referenced from inline assembly.
+ */
+class LocalVariableCollector: private ASTConstVisitor
+{
+public:
+	explicit LocalVariableCollector(ASTNode const& _node) { _node.accept(*this); }
+
+	std::vector<VariableDeclaration const*> const& localVariables() const { return m_localVariables; }
+	std::set<Declaration const*> const& assemblyReferences() const { return m_assemblyReferences; }
+	std::vector<InlineAssembly const*> const& inlineAssemblyBlocks() const { return m_inlineAssemblyBlocks; }
+
+private:
+	bool visit(VariableDeclarationStatement const& _statement) override
+	{
+		for (auto const& declaration: _statement.declarations())
+			if (declaration)
+				m_localVariables.push_back(declaration.get());
+		return true;
+	}
+	bool visit(InlineAssembly const& _inlineAssembly) override
+	{
+		m_inlineAssemblyBlocks.push_back(&_inlineAssembly);
+		for (auto const& reference: _inlineAssembly.annotation().externalReferences)
+			m_assemblyReferences.insert(reference.second.declaration);
+		return false;
+	}
+
+	std::vector<VariableDeclaration const*> m_localVariables;
+	std::set<Declaration const*> m_assemblyReferences;
+	std::vector<InlineAssembly const*> m_inlineAssemblyBlocks;
+};
+
+/// @returns true if @a _callable can be reached from itself in @a _graph.
+bool isRecursive(CallGraph const& _graph, CallableDeclaration const& _callable)
+{
+	CallGraph::Node const start{&_callable};
+	std::set<CallGraph::Node, CallGraph::CompareByID> visited;
+	std::vector<CallGraph::Node> toVisit{start};
+	while (!toVisit.empty())
+	{
+		CallGraph::Node node = toVisit.back();
+		toVisit.pop_back();
+		auto callees = _graph.edges.find(node);
+		if (callees == _graph.edges.end())
+			continue;
+		for (CallGraph::Node const& callee: callees->second)
+		{
+			if (callee == start)
+				return true;
+			if (visited.insert(callee).second)
+				toVisit.push_back(callee);
+		}
+	}
+	return false;
+}
+
 }
 
 void ContractCompiler::compileContract(
@@ -616,6 +676,33 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 
 	m_context.startFunction(_function);
 
+	// If the function runs out of stack slots, its code is generated again with
+	// local variables moved to memory. This does not change the code of functions
+	// that compile without it.
+	CompilerContext::Checkpoint const checkpoint = m_context.checkpoint();
+	std::vector<VariableDeclaration const*> spilledVariables;
+	try
+	{
+		appendFunctionCode(_function);
+		return false;
+	}
+	catch (StackTooDeepError const&)
+	{
+		spilledVariables = spillableLocalVariables(_function);
+		if (spilledVariables.empty())
+			throw;
+	}
+
+	m_context.resetToCheckpoint(checkpoint);
+	m_returnTags.clear();
+	for (VariableDeclaration const* variable: spilledVariables)
+		m_context.addSpilledVariable(*variable);
+	appendFunctionCode(_function);
+	return false;
+}
+
+void ContractCompiler::appendFunctionCode(FunctionDefinition const& _function)
+{
 	// stack upon entry: [return address] [arg0] [arg1] ... [argn]
 	// reserve additional slots: [retarg0] ... [retargm]
 
@@ -701,8 +788,39 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 		if (!_function.isFallback() && !_function.isReceive())
 			m_context.appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
 	}
+}
 
-	return false;
+std::vector<VariableDeclaration const*> ContractCompiler::spillableLocalVariables(FunctionDefinition const& _function)
+{
+	if (_function.isConstructor() || !m_context.canSpillVariables())
+		return {};
+
+	ContractDefinitionAnnotation const& annotation = m_context.mostDerivedContract().annotation();
+	auto const& callGraph = m_runtimeCompiler ? annotation.creationCallGraph : annotation.deployedCallGraph;
+	if (!callGraph.set())
+		return {};
+	CallGraph const& graph = **callGraph;
+	if (!graph.edges.count(&_function) || isRecursive(graph, _function))
+		return {};
+
+	if (!m_allInlineAssemblyMemorySafe.has_value())
+	{
+		m_allInlineAssemblyMemorySafe = true;
+		for (auto const& [node, callees]: graph.edges)
+			if (auto const* callable = std::get_if<CallableDeclaration const*>(&node))
+				for (InlineAssembly const* inlineAssembly: LocalVariableCollector(**callable).inlineAssemblyBlocks())
+					if (*inlineAssembly->annotation().hasMemoryEffects && !inlineAssembly->annotation().markedMemorySafe)
+						m_allInlineAssemblyMemorySafe = false;
+	}
+	if (!*m_allInlineAssemblyMemorySafe)
+		return {};
+
+	LocalVariableCollector collector(_function.body());
+	std::vector<VariableDeclaration const*> variables;
+	for (VariableDeclaration const* variable: collector.localVariables())
+		if (!collector.assemblyReferences().count(variable))
+			variables.push_back(variable);
+	return variables;
 }
 
 bool ContractCompiler::visit(InlineAssembly const& _inlineAssembly)
@@ -1367,7 +1485,10 @@ bool ContractCompiler::visit(VariableDeclarationStatement const& _variableDeclar
 			if (VariableDeclaration const* varDecl = declarations[j].get())
 			{
 				utils.convertType(*valueTypes[j], *varDecl->annotation().type);
-				utils.moveToStackVariable(*varDecl);
+				if (m_context.isSpilledVariable(varDecl))
+					SpilledVariable(m_context, *varDecl).storeValue(*varDecl->annotation().type, varDecl->location(), true);
+				else
+					utils.moveToStackVariable(*varDecl);
 			}
 			else
 				utils.popStackElement(*valueTypes[j]);
@@ -1519,6 +1640,12 @@ void ContractCompiler::appendStackVariableInitialisation(
 )
 {
 	CompilerContext::LocationSetter location(m_context, _variable);
+	if (m_context.isSpilledVariable(&_variable))
+	{
+		if (_provideDefaultValue)
+			SpilledVariable(m_context, _variable).setToZero(_variable.location());
+		return;
+	}
 	m_context.addVariable(_variable);
 	if (!_provideDefaultValue && _variable.type()->dataStoredIn(DataLocation::Memory))
 	{
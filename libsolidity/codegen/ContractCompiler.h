@@ -30,6 +30,8 @@
 #include <functional>
 #include <ostream>
 #include <map>
+#include <optional>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -105,6 +107,14 @@ private:
 
 	bool visit(VariableDeclaration const& _variableDeclaration) override;
 	bool visit(FunctionDefinition const& _function) override;
+	/// Appends the code of @a _function after its entry label.
+	void appendFunctionCode(FunctionDefinition const& _function);
+	/// @returns the local variables of @a _function that can be moved from the stack to memory
+	/// if the function runs out of stack slots.
+	/// This is only the case if the function is not recursive, none of the inline assembly blocks
+	/// that might be executed is unsafe regarding memory and the variable is not referenced
+	/// from inline assembly.
+	std::vector<VariableDeclaration const*> spillableLocalVariables(FunctionDefinition const& _function);
 	bool visit(InlineAssembly const& _inlineAssembly) override;
 	bool visit(TryStatement const& _tryStatement) override;
 	void handleCatch(std::vector<ASTPointer<TryCatchClause>> const& _catchClauses);
@@ -163,6 +173,9 @@ private:
 
 	/// Stores the variables that were declared inside a specific scope, for each modifier depth.
 	std::map<unsigned, std::map<ASTNode const*, unsigned>> m_scopeStackHeight;
+
+	/// Whether all inline assembly blocks reachable in the call graph are memory-safe, if already determined.
+	std::optional<bool> m_allInlineAssemblyMemorySafe;
 };
 
 }
@@ -2937,6 +2937,8 @@ void ExpressionCompiler::setLValueFromDeclaration(Declaration const& _declaratio
 {
 	if (m_context.isLocalVariable(&_declaration))
 		setLValue<StackVariable>(_expression, dynamic_cast<VariableDeclaration const&>(_declaration));
+	else if (m_context.isSpilledVariable(&_declaration))
+		setLValue<SpilledVariable>(_expression, dynamic_cast<VariableDeclaration const&>(_declaration));
 	else if (m_context.isStateVariable(&_declaration))
 		setLValue<StorageItem>(_expression, dynamic_cast<VariableDeclaration const&>(_declaration));
 	else
@@ -80,6 +80,34 @@ void StackVariable::setToZero(SourceLocation const& _location, bool) const
 	storeValue(*m_dataType, _location, true);
 }
 
+SpilledVariable::SpilledVariable(CompilerContext& _compilerContext, VariableDeclaration const& _declaration):
+	LValue(_compilerContext, _declaration.annotation().type),
+	m_memoryOffset(m_context.spilledVariableMemoryOffset(_declaration)),
+	m_size(m_dataType->sizeOnStack())
+{
+}
+
+void SpilledVariable::retrieveValue(SourceLocation const&, bool) const
+{
+	for (unsigned i = 0; i < m_size; ++i)
+		m_context << u256(m_memoryOffset + 32 * i) << Instruction::MLOAD;
+}
+
+void SpilledVariable::storeValue(Type const&, SourceLocation const&, bool _move) const
+{
+	if (!_move)
+		for (unsigned i = 0; i < m_size; ++i)
+			m_context << dupInstruction(m_size);
+	for (unsigned i = m_size; i > 0; --i)
+		m_context << u256(m_memoryOffset + 32 * (i - 1)) << Instruction::MSTORE;
+}
+
+void SpilledVariable::setToZero(SourceLocation const& _location, bool) const
+{
+	CompilerUtils(m_context).pushZeroValue(*m_dataType);
+	storeValue(*m_dataType, _location, true);
+}
+
 MemoryItem::MemoryItem(CompilerContext& _compilerContext, Type const& _type, bool _padded):
 	LValue(_compilerContext, &_type),
 	m_padded(_padded)
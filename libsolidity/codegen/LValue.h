@@ -101,6 +101,34 @@ private:
 	unsigned m_size;
 };
 
+/**
+ * Local variable that was moved from the stack to a fixed location in memory
+ * to avoid exceeding the reachable stack depth.
+ */
+class SpilledVariable: public LValue
+{
+public:
+	SpilledVariable(CompilerContext& _compilerContext, VariableDeclaration const& _declaration);
+
+	unsigned sizeOnStack() const override { return 0; }
+	void retrieveValue(langutil::SourceLocation const& _location, bool _remove = false) const override;
+	void storeValue(
+		Type const& _sourceType,
+		langutil::SourceLocation const& _location = {},
+		bool _move = false
+	) const override;
+	void setToZero(
+		langutil::SourceLocation const& _location = {},
+		bool _removeReference = true
+	) const override;
+
+private:
+	/// Memory offset of the first stack slot of the value.
+	size_t m_memoryOffset;
+	/// Number of stack elements occupied by the value.
+	unsigned m_size;
+};
+
 /**
  * Reference to some item in memory.
  */
@@ -23,6 +23,7 @@
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolutil/CommonData.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 
@@ -78,3 +79,20 @@ std::string MultiUseYulFunctionCollector::createFunction(
 	}
 	return _name;
 }
+
+std::string MultiUseYulFunctionCollector::createDataObject(std::string const& _name, bytes const& _data)
+{
+	solAssert(m_dataObjectSettings, "Data objects are not available.");
+	solAssert(!_name.empty(), "");
+	if (m_requestedDataObjects.insert(_name).second)
+		m_dataObjects += "data " + escapeAndQuoteString(_name) + " hex\"" + util::toHex(_data) + "\"\n";
+	return _name;
+}
+
+std::string MultiUseYulFunctionCollector::requestedDataObjects()
+{
+	std::string result = std::move(m_dataObjects);
+	m_dataObjects.clear();
+	m_requestedDataObjects.clear();
+	return result;
+}
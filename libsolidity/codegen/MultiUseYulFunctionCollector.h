@@ -22,8 +22,11 @@
 
 #pragma once
 
+#include <libsolutil/Common.h>
+
 #include <functional>
 #include <map>
+#include <optional>
 #include <string>
 #include <set>
 
@@ -32,7 +35,7 @@ namespace solidity::frontend
 
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
- * only once.
+ * only once. Optionally also collects data objects referenced by these functions.
  */
 class MultiUseYulFunctionCollector
 {
@@ -56,9 +59,35 @@ public:
 	/// @returns true IFF a function with the specified name has already been collected.
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
+	/// Properties of the code the collected functions are part of, which are needed to decide
+	/// whether data is better stored in a data object than in the code.
+	struct DataObjectSettings
+	{
+		bool isCreation = false;
+		size_t expectedExecutionsPerDeployment = 0;
+	};
+
+	/// Allows functions to use data objects, which is only possible if the collected functions
+	/// are placed into a Yul object together with the result of requestedDataObjects().
+	void enableDataObjects(DataObjectSettings _settings) { m_dataObjectSettings = _settings; }
+	/// @returns the settings passed to enableDataObjects or nullopt if data objects are not available.
+	std::optional<DataObjectSettings> const& dataObjectSettings() const { return m_dataObjectSettings; }
+
+	/// Adds a data object with name @a _name and content @a _data, unless one with this name
+	/// has been added already. Requires data objects to be enabled.
+	/// @returns @a _name.
+	std::string createDataObject(std::string const& _name, bytes const& _data);
+
+	/// @returns the Yul source of all data objects in the order in which they were created.
+	/// Clears the internal list, i.e. calling it again will result in an empty return value.
+	std::string requestedDataObjects();
+
 private:
 	std::set<std::string> m_requestedFunctions;
 	std::string m_code;
+	std::optional<DataObjectSettings> m_dataObjectSettings;
+	std::set<std::string> m_requestedDataObjects;
+	std::string m_dataObjects;
 };
 
 }
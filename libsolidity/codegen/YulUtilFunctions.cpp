@@ -25,6 +25,8 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <libsolutil/CommonData.h>
 #include <libsolutil/FunctionSelector.h>
 #include <libsolutil/Whiskers.h>
@@ -145,6 +147,20 @@ std::string YulUtilFunctions::storeLiteralInMemoryFunction(std::string const& _l
 
 	return m_functionCollector.createFunction(functionName, [&]() {
 		size_t words = (_literal.length() + 31) / 32;
+		if (literalCheaperInDataObject(words))
+		{
+			bytes data = asBytes(_literal);
+			data.resize(words * 32, 0);
+			return Whiskers(R"(
+				function <functionName>(memPtr) {
+					datacopy(memPtr, dataoffset("<dataName>"), datasize("<dataName>"))
+				}
+			)")
+			("functionName", functionName)
+			("dataName", m_functionCollector.createDataObject("literal_" + util::toHex(util::keccak256(_literal).asBytes()), data))
+			.render();
+		}
+
 		std::vector<std::map<std::string, std::string>> wordParams(words);
 		for (size_t i = 0; i < words; ++i)
 		{
@@ -165,6 +181,25 @@ std::string YulUtilFunctions::storeLiteralInMemoryFunction(std::string const& _l
 	});
 }
 
+bool YulUtilFunctions::literalCheaperInDataObject(size_t _words) const
+{
+	auto const& settings = m_functionCollector.dataObjectSettings();
+	if (!settings || _words == 0)
+		return false;
+
+	bigint runs = settings->isCreation ? 1 : settings->expectedExecutionsPerDeployment;
+	bigint byteCost = settings->isCreation ?
+		bigint(evmasm::GasCosts::txDataNonZeroGas(m_evmVersion)) :
+		bigint(evmasm::GasCosts::createDataGas);
+	// Storing a word takes PUSH32, a push of the offset, DUP, ADD and MSTORE.
+	bigint storeCost = runs * 15 * _words + byteCost * 38 * _words;
+	// Copying takes two pushes, DUP and CODECOPY plus the padded data itself.
+	bigint copyCost =
+		runs * (12 + evmasm::GasCosts::copyGas * _words) +
+		byteCost * (8 + 32 * _words);
+	return copyCost < storeCost;
+}
+
 std::string YulUtilFunctions::copyLiteralToStorageFunction(std::string const& _literal)
 {
 	std::string functionName = "copy_literal_to_storage_" + util::toHex(util::keccak256(_literal).asBytes());
@@ -83,6 +83,8 @@ public:
 	std::string copyLiteralToMemoryFunction(std::string const& _literal);
 
 	/// @returns the name of a function that stores a string literal at a specific location in memory
+	/// (padded with zeros to a multiple of 32 bytes). If data objects are enabled in the function collector
+	/// and it is expected to be cheaper, the literal is copied from a data object instead of being stored word by word.
 	/// signature: (memPtr) ->
 	std::string storeLiteralInMemoryFunction(std::string const& _literal);
 
@@ -531,6 +533,11 @@ public:
 	std::string externalFunctionPointersEqualFunction();
 
 private:
+	/// @returns true if copying a literal of @a _words 32 byte words from a data object is expected
+	/// to be cheaper than storing it word by word, taking into account both the size of the code and
+	/// the gas costs for the expected number of executions.
+	bool literalCheaperInDataObject(size_t _words) const;
+
 	/// @returns the name of a function that copies a struct from calldata or memory to storage
 	/// signature: (slot, value) ->
 	std::string copyStructToStorageFunction(StructType const& _from, StructType const& _to);
@@ -145,10 +145,10 @@ std::string IRGenerator::generate(
 					<dispatch>
 					<deployedFunctions>
 				}
-				<deployedSubObjects>
+				<deployedDataObjects><deployedSubObjects>
 				data "<metadataName>" hex"<cborMetadata>"
 			}
-			<subObjects>
+			<dataObjects><subObjects>
 		}
 	)");
 
@@ -183,6 +183,7 @@ std::string IRGenerator::generate(
 
 	t("functions", m_context.functionCollector().requestedFunctions());
 	t("subObjects", subObjectSources(m_context.subObjectsCreated()));
+	t("dataObjects", m_context.functionCollector().requestedDataObjects());
 
 	// This has to be called only after all other code generation for the creation object is complete.
 	bool creationInvolvesMemoryUnsafeAssembly = m_context.memoryUnsafeInlineAssemblySeen();
@@ -205,6 +206,7 @@ std::string IRGenerator::generate(
 	generateInternalDispatchFunctions(_contract);
 	t("deployedFunctions", m_context.functionCollector().requestedFunctions());
 	t("deployedSubObjects", subObjectSources(m_context.subObjectsCreated()));
+	t("deployedDataObjects", m_context.functionCollector().requestedDataObjects());
 	t("metadataName", yul::Object::metadataName());
 	t("cborMetadata", util::toHex(_cborMetadata));
 
@@ -1100,6 +1102,12 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 	);
 	m_context = std::move(newContext);
 
+	if (m_optimiserSettings.largeLiteralsInData)
+		m_context.functionCollector().enableDataObjects({
+			_context == ExecutionContext::Creation,
+			m_optimiserSettings.expectedExecutionsPerDeployment
+		});
+
 	m_context.setMostDerivedContract(_contract);
 	for (auto const& var: ContractType(_contract).stateVariables())
 		m_context.addStateVariable(*std::get<0>(var), std::get<1>(var), std::get<2>(var));
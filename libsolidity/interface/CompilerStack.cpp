@@ -91,9 +91,13 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <functional>
 #include <utility>
 #include <map>
 #include <limits>
+#include <mutex>
+#include <set>
 #include <string>
 
 using namespace solidity;
@@ -105,21 +109,31 @@ using namespace std::string_literals;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
+namespace
+{
+/// Type providers in use by a compiler stack.
+std::set<TypeProvider const*> g_usedTypeProviders;
+std::mutex g_usedTypeProvidersMutex;
+}
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
+	m_typeProvider{TypeProvider::instance()},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
+	// Because the types are shared by everything using the same TypeProvider, we must ensure that
 	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
+	std::lock_guard<std::mutex> lock(g_usedTypeProvidersMutex);
+	solAssert(g_usedTypeProviders.insert(&m_typeProvider).second, "You shall not have another CompilerStack aside me.");
 }
 
 CompilerStack::~CompilerStack()
 {
-	--g_compilerStackCounts;
+	{
+		std::lock_guard<std::mutex> lock(g_usedTypeProvidersMutex);
+		g_usedTypeProviders.erase(&m_typeProvider);
+	}
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	TypeProvider::reset();
 }
 
@@ -309,8 +323,10 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, std::string const& _re
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	m_stackState = Empty;
 	m_sources.clear();
+	m_importClosures.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
@@ -321,6 +337,7 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
+		m_retainedArtifacts = RetainedArtifacts{};
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
@@ -332,6 +349,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_objectOptimizer.reset();
 	m_errorReporter.clear();
 	TypeProvider::reset();
 }
@@ -349,6 +367,7 @@ void CompilerStack::setSources(StringMap _sources)
 
 bool CompilerStack::parse()
 {
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	if (m_stackState != SourcesSet)
 		solThrow(CompilerError, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
@@ -439,6 +458,7 @@ void CompilerStack::importASTs(std::map<std::string, Json::Value> const& _source
 
 bool CompilerStack::analyze()
 {
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	if (m_stackState != ParsedAndImported)
 		solThrow(CompilerError, "Must call analyze only after parsing was successful.");
 
@@ -703,6 +723,7 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 
 bool CompilerStack::compile(State _stopAfter)
 {
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisSuccessful)
 		if (!parseAndAnalyze(_stopAfter))
@@ -714,6 +735,71 @@ bool CompilerStack::compile(State _stopAfter)
 	// Only compile contracts individually which have been requested.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
 
+	// The optimized Yul objects refer to interned strings, so they are only kept during compilation.
+	m_objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
+	ScopeGuard releaseObjectOptimizer([&]() { m_objectOptimizer.reset(); });
+
+	// Contracts whose code has been generated, either because they were requested
+	// or because a requested contract depends on them.
+	std::set<ContractDefinition const*> generatedContracts;
+	std::set<ContractDefinition const*> processedRequestedContracts;
+	// Contracts depending on a contract, among the ones that will be compiled.
+	std::map<ContractDefinition const*, std::set<ContractDefinition const*>> dependents;
+	std::function<void(ContractDefinition const&)> collectDependents = [&](ContractDefinition const& _contract) {
+		for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+			if (dependents[dependency].insert(&_contract).second)
+				collectDependents(*dependency);
+	};
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+				if (isRequestedContract(*contract))
+					collectDependents(*contract);
+
+	// Releases the artifacts of a contract that were not requested as soon as the contract
+	// and everything depending on it has been compiled. This keeps the memory usage of
+	// large builds proportional to the size of the dependency chains instead of the
+	// number of contracts.
+	auto const releaseFinishedContracts = [&](ContractDefinition const& _requestedContract) {
+		processedRequestedContracts.insert(&_requestedContract);
+		std::vector<ContractDefinition const*> newlyGenerated;
+		util::BreadthFirstSearch<ContractDefinition const*>{{&_requestedContract}}.run(
+			[&](ContractDefinition const* _contract, auto&& _addChild) {
+				if (generatedContracts.insert(_contract).second)
+					newlyGenerated.push_back(_contract);
+				for (auto const& [dependency, referencee]: _contract->annotation().contractDependencies)
+					_addChild(dependency);
+			}
+		);
+
+		std::set<ContractDefinition const*> candidates{&_requestedContract};
+		for (ContractDefinition const* contract: newlyGenerated)
+		{
+			candidates.insert(contract);
+			for (auto const& [dependency, referencee]: contract->annotation().contractDependencies)
+				candidates.insert(dependency);
+		}
+		for (ContractDefinition const* contract: candidates)
+		{
+			if (
+				!generatedContracts.count(contract) ||
+				(isRequestedContract(*contract) && !processedRequestedContracts.count(contract))
+			)
+				continue;
+			if (std::all_of(
+				dependents[contract].begin(),
+				dependents[contract].end(),
+				[&](ContractDefinition const* _dependent) { return generatedContracts.count(_dependent) > 0; }
+			))
+			{
+				releaseUnretainedArtifacts(m_contracts.at(contract->fullyQualifiedName()));
+				// Keep the entry so that the contract is not compiled again.
+				if (otherCompilers.count(contract))
+					otherCompilers[contract] = nullptr;
+			}
+		}
+	};
+
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
@@ -765,6 +851,7 @@ bool CompilerStack::compile(State _stopAfter)
 						else
 							throw;
 					}
+					releaseFinishedContracts(*contract);
 				}
 	m_stackState = CompilationSuccessful;
 	this->link();
@@ -870,11 +957,7 @@ std::string const* CompilerStack::sourceMapping(std::string const& _contractName
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	Contract const& c = contract(_contractName);
-	if (!c.sourceMapping)
-	{
-		if (auto items = assemblyItems(_contractName))
-			c.sourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices()));
-	}
+	computeSourceMappings(c);
 	return c.sourceMapping ? &*c.sourceMapping : nullptr;
 }
 
@@ -884,16 +967,26 @@ std::string const* CompilerStack::runtimeSourceMapping(std::string const& _contr
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	Contract const& c = contract(_contractName);
-	if (!c.runtimeSourceMapping)
-	{
-		if (auto items = runtimeAssemblyItems(_contractName))
-			c.runtimeSourceMapping.emplace(
-				evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices())
-			);
-	}
+	computeSourceMappings(c);
 	return c.runtimeSourceMapping ? &*c.runtimeSourceMapping : nullptr;
 }
 
+void CompilerStack::computeSourceMappings(Contract const& _contract) const
+{
+	if (_contract.sourceMapping || _contract.runtimeSourceMapping || !_contract.evmAssembly)
+		return;
+
+	// Both mappings are requested together in practice, so resolve the source indices only once.
+	std::map<std::string, unsigned> const indices = sourceIndices();
+	_contract.sourceMapping.emplace(
+		evmasm::AssemblyItem::computeSourceMapping(_contract.evmAssembly->items(), indices)
+	);
+	if (_contract.evmRuntimeAssembly)
+		_contract.runtimeSourceMapping.emplace(
+			evmasm::AssemblyItem::computeSourceMapping(_contract.evmRuntimeAssembly->items(), indices)
+		);
+}
+
 std::string const CompilerStack::filesystemFriendlyName(std::string const& _contractName) const
 {
 	if (m_stackState < AnalysisSuccessful)
@@ -1192,6 +1285,27 @@ std::string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
+Json::Value const& CompilerStack::Source::metadata(bool _literalSources) const
+{
+	if (metadataCached.isNull())
+	{
+		solAssert(charStream, "Character stream not available");
+		metadataCached = Json::objectValue;
+		metadataCached["keccak256"] = "0x" + util::toHex(keccak256().asBytes());
+		if (std::optional<std::string> licenseString = ast->licenseString())
+			metadataCached["license"] = *licenseString;
+		if (_literalSources)
+			metadataCached["content"] = charStream->source();
+		else
+		{
+			metadataCached["urls"] = Json::arrayValue;
+			metadataCached["urls"].append("bzz-raw://" + util::toHex(swarmHash().asBytes()));
+			metadataCached["urls"].append(ipfsUrl());
+		}
+	}
+	return metadataCached;
+}
+
 StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
@@ -1508,12 +1622,15 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		otherYulSources
 	);
 
+	// The native source locations of objects that are shared with other contracts refer to the IR of the
+	// contract they were first optimized in. Only share objects if they do not end up in the optimized AST.
 	yul::YulStack stack(
 		m_evmVersion,
 		m_eofVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
-		m_debugInfoSelection
+		m_debugInfoSelection,
+		m_retainedArtifacts.irOptimizedAst ? nullptr : m_objectOptimizer
 	);
 	bool yulAnalysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIR);
 	solAssert(
@@ -1523,10 +1640,12 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		langutil::SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
 	);
 
-	compiledContract.yulIRAst = stack.astJson();
+	if (m_retainedArtifacts.irAst)
+		compiledContract.yulIRAst = stack.astJson();
 	stack.optimize();
 	compiledContract.yulIROptimized = stack.print(this);
-	compiledContract.yulIROptimizedAst = stack.astJson();
+	if (m_retainedArtifacts.irOptimizedAst)
+		compiledContract.yulIROptimizedAst = stack.astJson();
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1560,6 +1679,25 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
+void CompilerStack::releaseUnretainedArtifacts(Contract& _contract)
+{
+	if (!m_retainedArtifacts.ir)
+		_contract.yulIR = {};
+	if (!m_retainedArtifacts.irOptimized)
+		_contract.yulIROptimized = {};
+	if (!m_retainedArtifacts.irAst)
+		_contract.yulIRAst = Json::nullValue;
+	if (!m_retainedArtifacts.irOptimizedAst)
+		_contract.yulIROptimizedAst = Json::nullValue;
+	if (!m_retainedArtifacts.evmAssembly)
+	{
+		_contract.evmAssembly.reset();
+		_contract.evmRuntimeAssembly.reset();
+	}
+	if (!m_retainedArtifacts.generatedSources)
+		_contract.compiler.reset();
+}
+
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -1600,6 +1738,28 @@ CompilerStack::Source const& CompilerStack::source(std::string const& _sourceNam
 	return it->second;
 }
 
+std::set<std::string> const& CompilerStack::importClosure(SourceUnit const& _sourceUnit) const
+{
+	if (auto const* closure = util::valueOrNullptr(m_importClosures, &_sourceUnit))
+		return *closure;
+
+	std::set<std::string> closure{*_sourceUnit.annotation().path};
+	// The closure of an already memoized source unit is complete, so it does not need to be traversed again.
+	// This also holds in the presence of import cycles.
+	util::BreadthFirstSearch<SourceUnit const*>{{&_sourceUnit}}.run([&](SourceUnit const* _unit, auto&& _addChild) {
+		if (_unit != &_sourceUnit)
+			if (auto const* importedClosure = util::valueOrNullptr(m_importClosures, _unit))
+			{
+				closure += *importedClosure;
+				return;
+			}
+		closure.insert(*_unit->annotation().path);
+		for (SourceUnit const* importedUnit: _unit->referencedSourceUnits())
+			_addChild(importedUnit);
+	});
+	return m_importClosures[&_sourceUnit] = std::move(closure);
+}
+
 std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) const
 {
 	Json::Value meta{Json::objectValue};
@@ -1618,30 +1778,9 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 	meta["compiler"]["version"] = VersionStringStrict;
 
 	/// All the source files (including self), which should be included in the metadata.
-	std::set<std::string> referencedSources;
-	referencedSources.insert(*_contract.contract->sourceUnit().annotation().path);
-	for (auto const sourceUnit: _contract.contract->sourceUnit().referencedSourceUnits(true))
-		referencedSources.insert(*sourceUnit->annotation().path);
-
 	meta["sources"] = Json::objectValue;
-	for (auto const& s: m_sources)
-	{
-		if (!referencedSources.count(s.first))
-			continue;
-
-		solAssert(s.second.charStream, "Character stream not available");
-		meta["sources"][s.first]["keccak256"] = "0x" + util::toHex(s.second.keccak256().asBytes());
-		if (std::optional<std::string> licenseString = s.second.ast->licenseString())
-			meta["sources"][s.first]["license"] = *licenseString;
-		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.charStream->source();
-		else
-		{
-			meta["sources"][s.first]["urls"] = Json::arrayValue;
-			meta["sources"][s.first]["urls"].append("bzz-raw://" + util::toHex(s.second.swarmHash().asBytes()));
-			meta["sources"][s.first]["urls"].append(s.second.ipfsUrl());
-		}
-	}
+	for (std::string const& path: importClosure(_contract.contract->sourceUnit()))
+		meta["sources"][path] = m_sources.at(path).metadata(m_metadataLiteralSources);
 
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
 	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
@@ -1666,12 +1805,28 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+		// Only present if enabled, so that the metadata of existing settings is unchanged.
+		if (m_optimiserSettings.runJumpThreader)
+			details["jumpThreader"] = true;
+		if (m_optimiserSettings.compactJumpTags)
+			details["compactJumpTags"] = true;
+		if (m_optimiserSettings.largeLiteralsInData)
+			details["largeLiteralsInData"] = true;
+		if (m_optimiserSettings.packedStorageArrayCopy)
+			details["packedStorageArrayCopy"] = true;
 		details["simpleCounterForLoopUncheckedIncrement"] = m_optimiserSettings.simpleCounterForLoopUncheckedIncrement;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+			// Only present if enabled, so that the metadata of existing settings is unchanged.
+			if (m_optimiserSettings.outlineColdBlocks)
+				details["yulDetails"]["outlineColdBlocks"] = true;
+			if (m_optimiserSettings.eliminateTailCalls)
+				details["yulDetails"]["eliminateTailCalls"] = true;
+			if (m_optimiserSettings.isolatedFunctionOptimization)
+				details["yulDetails"]["isolatedFunctionOptimization"] = true;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps;
 		}
 		else if (
@@ -1892,34 +2047,50 @@ Json::Value CompilerStack::gasEstimates(std::string const& _contractName) const
 	{
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
-		Json::Value externalFunctions(Json::objectValue);
+		std::vector<std::string> externalSignatures;
 		for (auto it: contract.interfaceFunctions())
-		{
-			std::string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
-		}
-
+			externalSignatures.emplace_back(it.second->externalSignature());
+		std::vector<std::string> estimatedSignatures = externalSignatures;
 		if (contract.fallbackFunction())
+		{
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
+			externalSignatures.emplace_back("");
+			estimatedSignatures.emplace_back("INVALID");
+		}
+
+		std::vector<Gas> externalGas = gasEstimator.functionalEstimations(*items, estimatedSignatures);
+		Json::Value externalFunctions(Json::objectValue);
+		for (size_t i = 0; i < externalSignatures.size(); ++i)
+			externalFunctions[externalSignatures[i]] = gasToJson(externalGas[i]);
 
 		if (!externalFunctions.empty())
 			output["external"] = externalFunctions;
 
 		/// Internal functions
-		Json::Value internalFunctions(Json::objectValue);
+		std::vector<FunctionDefinition const*> internalFunctionDefinitions;
+		std::vector<std::pair<size_t, FunctionDefinition const*>> estimatedFunctions;
 		for (auto const& it: contract.definedFunctions())
 		{
 			/// Exclude externally visible functions, constructor, fallback and receive ether function
 			if (it->isPartOfExternalInterface() || !it->isOrdinary())
 				continue;
 
-			size_t entry = functionEntryPoint(_contractName, *it);
-			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
-			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
+			internalFunctionDefinitions.emplace_back(it);
+			if (size_t entry = functionEntryPoint(_contractName, *it); entry > 0)
+				estimatedFunctions.emplace_back(entry, it);
+		}
+
+		std::vector<Gas> estimatedGas = gasEstimator.functionalEstimations(*items, estimatedFunctions);
+		std::map<FunctionDefinition const*, Gas> internalGas;
+		for (size_t i = 0; i < estimatedFunctions.size(); ++i)
+			internalGas[estimatedFunctions[i].second] = estimatedGas[i];
+
+		Json::Value internalFunctions(Json::objectValue);
+		for (FunctionDefinition const* it: internalFunctionDefinitions)
+		{
+			Gas gas = internalGas.count(it) ? internalGas.at(it) : Gas::infinite();
 
 			/// TODO: This could move into a method shared with externalSignature()
 			FunctionType type(*it);
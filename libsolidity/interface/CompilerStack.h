@@ -63,6 +63,11 @@ class CharStream;
 }
 
 
+namespace solidity::yul
+{
+class ObjectOptimizer;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -82,6 +87,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class TypeProvider;
 namespace experimental
 {
 class Analysis;
@@ -127,7 +133,8 @@ public:
 		SolidityAST,
 	};
 
-	/// Creates a new compiler stack.
+	/// Creates a new compiler stack that uses the type provider of the current thread.
+	/// There must not be another compiler stack using the same type provider.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
 	explicit CompilerStack(ReadCallback::Callback _readFile = ReadCallback::Callback());
@@ -196,6 +203,25 @@ public:
 	/// Enable generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
+	/// Per-contract intermediate artifacts that are kept after compilation.
+	/// Artifacts that are not selected are not created at all or released as soon as
+	/// the contract and every contract depending on it have been compiled.
+	struct RetainedArtifacts
+	{
+		bool ir = true;
+		bool irAst = true;
+		bool irOptimized = true;
+		bool irOptimizedAst = true;
+		/// Assembly of the contract, needed for assembly output, source mappings and gas estimates.
+		bool evmAssembly = true;
+		/// Yul utility code of the legacy code generator, needed for the generated sources.
+		bool generatedSources = true;
+	};
+
+	/// Selects the artifacts that are kept after compilation. By default, everything is kept.
+	/// Accessing an artifact that was not retained returns an empty value.
+	void setRetainedArtifacts(RetainedArtifacts const& _retainedArtifacts) { m_retainedArtifacts = _retainedArtifacts; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -362,10 +388,14 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		Json::Value mutable metadataCached;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
 		std::string const& ipfsUrl() const;
+		/// @returns the entry of the source in the "sources" section of the metadata of contracts referencing it.
+		/// @a _literalSources has to be the same on every call.
+		Json::Value const& metadata(bool _literalSources) const;
 	};
 
 	/// The state per contract. Filled gradually during compilation.
@@ -446,6 +476,11 @@ private:
 	/// Depends on output generated by generateIR.
 	void generateEVMFromIR(ContractDefinition const& _contract);
 
+	/// Releases all intermediate artifacts of @a _contract that are not selected in m_retainedArtifacts.
+	/// Must only be called once neither the contract itself nor any contract depending on it
+	/// will be compiled anymore.
+	void releaseUnretainedArtifacts(Contract& _contract);
+
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
@@ -454,10 +489,17 @@ private:
 	/// Can only be called after state is CompilationSuccessful.
 	Contract const& contract(std::string const& _contractName) const;
 
+	/// Fills the creation and runtime source mappings of @a _contract if not computed yet.
+	void computeSourceMappings(Contract const& _contract) const;
+
 	/// @returns the source object for the given @a _sourceName.
 	/// Can only be called after state is SourcesSet.
 	Source const& source(std::string const& _sourceName) const;
 
+	/// @returns the paths of @a _sourceUnit and of all source units it imports directly or indirectly.
+	/// The result is memoized per source unit and reuses the results of the imported source units.
+	std::set<std::string> const& importClosure(SourceUnit const& _sourceUnit) const;
+
 	/// @param _forIR If true, include a flag that indicates that the bytecode comes from IR codegen.
 	/// @returns the metadata JSON as a compact string for the given contract.
 	std::string createMetadata(Contract const& _contract, bool _forIR) const;
@@ -494,6 +536,8 @@ private:
 	) const;
 
 	ReadCallback::Callback m_readFile;
+	/// Type provider of the thread that created the stack, activated while parsing, analysing and compiling.
+	TypeProvider& m_typeProvider;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
@@ -504,14 +548,20 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	RetainedArtifacts m_retainedArtifacts;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
+	/// Memoized results of @a importClosure.
+	mutable std::map<SourceUnit const*, std::set<std::string>> m_importClosures;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Optimizer of Yul objects shared by the IR of all contracts during compilation, so that the objects of
+	/// contracts created by other contracts are only optimized once.
+	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -33,9 +33,13 @@
 #include <libsolutil/FunctionSelector.h>
 #include <libsolutil/Keccak256.h>
 
+#include <atomic>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <system_error>
+#include <thread>
 
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -46,6 +50,55 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	AssemblyItems const& _items,
 	std::string const& _signature
 ) const
+{
+	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, initialState(_signature));
+}
+
+GasEstimator::GasConsumption GasEstimator::functionalEstimation(
+	AssemblyItems const& _items,
+	size_t const& _offset,
+	FunctionDefinition const& _function
+) const
+{
+	std::shared_ptr<KnownState> state = initialState(_function);
+	if (!state)
+		return GasConsumption::infinite();
+	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+}
+
+std::vector<GasEstimator::GasConsumption> GasEstimator::functionalEstimations(
+	AssemblyItems const& _items,
+	std::vector<std::string> const& _signatures
+) const
+{
+	auto tagPositions = PathGasMeter::tagPositions(_items);
+	std::vector<std::shared_ptr<KnownState>> states;
+	for (std::string const& signature: _signatures)
+		states.emplace_back(initialState(signature));
+	return estimateConcurrently(states.size(), [&](size_t _index) {
+		return PathGasMeter(_items, tagPositions, m_evmVersion).estimateMax(0, states[_index]);
+	});
+}
+
+std::vector<GasEstimator::GasConsumption> GasEstimator::functionalEstimations(
+	AssemblyItems const& _items,
+	std::vector<std::pair<size_t, FunctionDefinition const*>> const& _functions
+) const
+{
+	auto tagPositions = PathGasMeter::tagPositions(_items);
+	// The initial states are computed upfront because determining the size of the
+	// parameters on the stack caches information inside the types.
+	std::vector<std::shared_ptr<KnownState>> states;
+	for (auto const& function: _functions)
+		states.emplace_back(initialState(*function.second));
+	return estimateConcurrently(states.size(), [&](size_t _index) {
+		if (!states[_index])
+			return GasConsumption::infinite();
+		return PathGasMeter(_items, tagPositions, m_evmVersion).estimateMax(_functions[_index].first, states[_index]);
+	});
+}
+
+std::shared_ptr<KnownState> GasEstimator::initialState(std::string const& _signature) const
 {
 	auto state = std::make_shared<KnownState>();
 
@@ -78,20 +131,16 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return state;
 }
 
-GasEstimator::GasConsumption GasEstimator::functionalEstimation(
-	AssemblyItems const& _items,
-	size_t const& _offset,
-	FunctionDefinition const& _function
-) const
+std::shared_ptr<KnownState> GasEstimator::initialState(FunctionDefinition const& _function)
 {
 	auto state = std::make_shared<KnownState>();
 
 	unsigned parametersSize = CompilerUtils::sizeOnStack(_function.parameters());
 	if (parametersSize > 16)
-		return GasConsumption::infinite();
+		return nullptr;
 
 	// Store an invalid return value on the stack, so that the path estimator breaks upon reaching
 	// the return jump.
@@ -100,7 +149,42 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	if (parametersSize > 0)
 		state->feedItem(swapInstruction(parametersSize));
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+	return state;
+}
+
+std::vector<GasEstimator::GasConsumption> GasEstimator::estimateConcurrently(
+	size_t _count,
+	std::function<GasConsumption(size_t)> const& _estimate
+)
+{
+	std::vector<GasConsumption> results(_count);
+	std::atomic<size_t> nextIndex{0};
+	auto worker = [&]() {
+		for (size_t index = nextIndex++; index < _count; index = nextIndex++)
+			results[index] = _estimate(index);
+	};
+
+	// The results are stored by index, so their order does not depend on the number of threads.
+	std::vector<std::future<void>> helpers;
+#ifndef __EMSCRIPTEN__
+	size_t const threads = std::min<size_t>(_count, std::max(1u, std::thread::hardware_concurrency()));
+	for (size_t i = 1; i < threads; ++i)
+		try
+		{
+			helpers.emplace_back(std::async(std::launch::async, worker));
+		}
+		catch (std::system_error const&)
+		{
+			// No more threads can be started, the remaining functions are estimated by the threads
+			// that are already running.
+			break;
+		}
+#endif
+	worker();
+	for (auto& helper: helpers)
+		helper.get();
+
+	return results;
 }
 
 std::set<ASTNode const*> GasEstimator::finestNodesAtLocation(
@@ -29,9 +29,16 @@
 #include <libevmasm/GasMeter.h>
 
 #include <array>
+#include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 
+namespace solidity::evmasm
+{
+class KnownState;
+}
+
 namespace solidity::frontend
 {
 
@@ -64,7 +71,38 @@ public:
 		FunctionDefinition const& _function
 	) const;
 
+	/// @returns the estimated gas consumption for each of the given signatures, in the same order.
+	/// The estimations are independent and run concurrently. Each of them is the same upper
+	/// bound over all paths that @a functionalEstimation reports, i.e. it is infinite as soon
+	/// as a path contains a loop.
+	std::vector<GasConsumption> functionalEstimations(
+		evmasm::AssemblyItems const& _items,
+		std::vector<std::string> const& _signatures
+	) const;
+
+	/// @returns the estimated gas consumption for each of the given functions together with
+	/// their offsets into the list of assembly items, in the same order.
+	/// The estimations are independent and run concurrently, with the same results and
+	/// limitations as @a functionalEstimation.
+	std::vector<GasConsumption> functionalEstimations(
+		evmasm::AssemblyItems const& _items,
+		std::vector<std::pair<size_t, FunctionDefinition const*>> const& _functions
+	) const;
+
 private:
+	/// @returns the initial state for estimating the gas consumption of the public or
+	/// external function with the given signature.
+	std::shared_ptr<evmasm::KnownState> initialState(std::string const& _signature) const;
+	/// @returns the initial state for estimating the gas consumption of the given internal
+	/// function or nullptr if its parameters do not fit on the stack.
+	static std::shared_ptr<evmasm::KnownState> initialState(FunctionDefinition const& _function);
+	/// Calls @a _estimate for every index less than @a _count, distributing the calls over
+	/// multiple threads, and @returns the results in order of the indices.
+	/// The calls are made on the current thread only if no further threads can be started.
+	static std::vector<GasConsumption> estimateConcurrently(
+		size_t _count,
+		std::function<GasConsumption(size_t)> const& _estimate
+	);
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
 	langutil::EVMVersion m_evmVersion;
@@ -119,11 +119,19 @@ struct OptimiserSettings
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
+			runJumpThreader == _other.runJumpThreader &&
+			compactJumpTags == _other.compactJumpTags &&
+			largeLiteralsInData == _other.largeLiteralsInData &&
+			packedStorageArrayCopy == _other.packedStorageArrayCopy &&
 			simpleCounterForLoopUncheckedIncrement == _other.simpleCounterForLoopUncheckedIncrement &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
+			outlineColdBlocks == _other.outlineColdBlocks &&
+			eliminateTailCalls == _other.eliminateTailCalls &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			isolatedFunctionOptimization == _other.isolatedFunctionOptimization &&
+			yulFunctionCacheDirectory == _other.yulFunctionCacheDirectory;
 	}
 
 	bool operator!=(OptimiserSettings const& _other) const
@@ -147,12 +155,30 @@ struct OptimiserSettings
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
+	/// Jump threading and duplication of small blocks that end the control flow,
+	/// subject to the size/cost-trade-off.
+	bool runJumpThreader = false;
+	/// Encode jump targets with the smallest push width that fits their position
+	/// instead of a uniform width for the whole assembly.
+	bool compactJumpTags = false;
+	/// When generating code via IR, store large string literals in data objects and copy them to memory
+	/// instead of storing them word by word, if this is cheaper for the expected number of executions.
+	bool largeLiteralsInData = false;
+	/// When generating code via the legacy code generator, assemble whole storage slots when copying arrays
+	/// of small value types from memory to storage instead of updating every element in storage.
+	bool packedStorageArrayCopy = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool simpleCounterForLoopUncheckedIncrement = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool optimizeStackAllocation = false;
 	/// Allow unchecked arithmetic when incrementing the counter of certain kinds of 'for' loop
 	bool runYulOptimiser = false;
+	/// When generating code from Yul with stack allocation, move blocks that always revert and functions
+	/// that always revert behind all other code.
+	bool outlineColdBlocks = false;
+	/// When generating code from Yul with stack allocation, let function calls in tail position
+	/// return directly to the caller of the calling function.
+	bool eliminateTailCalls = false;
 	/// Sequence of optimisation steps to be performed by Yul optimiser.
 	/// Note that there are some hard-coded steps in the optimiser and you cannot disable
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
@@ -165,6 +191,13 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Let the Yul optimizer optimize self-contained top-level functions in isolation
+	/// before optimizing the whole object.
+	bool isolatedFunctionOptimization = false;
+	/// If not empty and @a isolatedFunctionOptimization is set, the functions optimized in isolation
+	/// are stored in this directory to reuse them in later compiler runs.
+	/// Does not affect the metadata, since the output does not depend on the contents of the directory.
+	std::string yulFunctionCacheDirectory;
 };
 
 }
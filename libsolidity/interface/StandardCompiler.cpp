@@ -314,6 +314,40 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns the intermediate artifacts that have to be kept after the compilation of a contract
+/// to produce the outputs requested for any of the contracts.
+CompilerStack::RetainedArtifacts retainedArtifacts(Json::Value const& _outputSelection)
+{
+	auto const isRequested = [&](std::vector<std::string> const& _artifacts) {
+		if (!_outputSelection.isObject())
+			return false;
+		for (auto const& fileRequests: _outputSelection)
+			for (auto const& requests: fileRequests)
+				for (auto const& artifact: _artifacts)
+					if (isArtifactRequested(requests, artifact, false))
+						return true;
+		return false;
+	};
+
+	CompilerStack::RetainedArtifacts artifacts;
+	artifacts.ir = isRequested({"ir"});
+	artifacts.irAst = isRequested({"irAst"});
+	artifacts.irOptimized = isRequested({"irOptimized"});
+	artifacts.irOptimizedAst = isRequested({"irOptimizedAst"});
+	artifacts.evmAssembly = isRequested({
+		"evm.assembly",
+		"evm.legacyAssembly",
+		"evm.gasEstimates",
+		"evm.bytecode.sourceMap",
+		"evm.deployedBytecode.sourceMap"
+	});
+	artifacts.generatedSources = isRequested({
+		"evm.bytecode.generatedSources",
+		"evm.deployedBytecode.generatedSources"
+	});
+	return artifacts;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret{Json::objectValue};
@@ -441,7 +475,7 @@ std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static std::set<std::string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement"};
+	static std::set<std::string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "jumpThreader", "compactJumpTags", "largeLiteralsInData", "packedStorageArrayCopy", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -600,6 +634,14 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "jumpThreader", settings.runJumpThreader))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "compactJumpTags", settings.compactJumpTags))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "largeLiteralsInData", settings.largeLiteralsInData))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "packedStorageArrayCopy", settings.packedStorageArrayCopy))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "simpleCounterForLoopUncheckedIncrement", settings.simpleCounterForLoopUncheckedIncrement))
@@ -616,10 +658,16 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 				return {std::move(settings)};
 			}
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "outlineColdBlocks", "eliminateTailCalls", "isolatedFunctionOptimization"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "outlineColdBlocks", settings.outlineColdBlocks))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "eliminateTailCalls", settings.eliminateTailCalls))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "isolatedFunctionOptimization", settings.isolatedFunctionOptimization))
+				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps, settings.yulOptimiserCleanupSteps, settings.runYulOptimiser))
 				return *error;
 		}
@@ -1189,6 +1237,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	compilerStack.setRetainedArtifacts(retainedArtifacts(_inputsAndSettings.outputSelection));
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -41,8 +41,10 @@
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <string>
+#include <thread>
 
 #include <fmt/format.h>
 
@@ -133,8 +135,8 @@ Json::Value semanticTokensLegend()
 LanguageServer::LanguageServer(Transport& _transport):
 	m_client{_transport},
 	m_handlers{
-		{"$/cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
-		{"cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
+		{"$/cancelRequest", [](auto, auto) {/* consumed by readMessages() */}},
+		{"cancelRequest", [](auto, auto) {/* consumed by readMessages() */}},
 		{"exit", [this](auto, auto) { m_state = (m_state == State::ShutdownRequested ? State::ExitRequested : State::ExitWithoutShutdown); }},
 		{"initialize", std::bind(&LanguageServer::handleInitialize, this, _1, _2)},
 		{"initialized", std::bind(&LanguageServer::handleInitialized, this, _1, _2)},
@@ -151,18 +153,16 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"workspace/didChangeConfiguration", std::bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
-	m_compilerStack{m_fileRepository.reader()}
+	m_analysis{std::make_shared<Analysis>(FileRepository("/" /* basePath */, {} /* no search paths */), 0)}
 {
 }
 
-Json::Value LanguageServer::toRange(SourceLocation const& _location)
+LanguageServer::Analysis::Analysis(FileRepository _fileRepository, size_t _generation):
+	fileRepository(std::move(_fileRepository)),
+	generation(_generation)
 {
-	return HandlerBase(*this).toRange(_location);
-}
-
-Json::Value LanguageServer::toJson(SourceLocation const& _location)
-{
-	return HandlerBase(*this).toJson(_location);
+	TypeProvider::Scope typeProviderScope(typeProvider);
+	compilerStack = std::make_unique<CompilerStack>(fileRepository.reader());
 }
 
 void LanguageServer::changeConfiguration(Json::Value const& _settings)
@@ -213,7 +213,7 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 	}
 }
 
-std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject() const
+std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject(boost::filesystem::path const& _basePath)
 {
 	std::vector<fs::path> collectedPaths{};
 
@@ -221,9 +221,9 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	// open for a future PR to enable such a feature to be optionally enabled (default disabled).
 	// Note: Newer versions of boost have deprecated symlink_option::recurse
 #if (BOOST_VERSION < 107200)
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::symlink_option::recurse);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::symlink_option::recurse);
 #else
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::directory_options::follow_directory_symlink);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::directory_options::follow_directory_symlink);
 #endif
 	for (fs::directory_entry const& dirEntry: directoryIterator)
 		if (
@@ -235,52 +235,156 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+std::shared_ptr<LanguageServer::Analysis> LanguageServer::analyse(AnalysisRequest const& _request)
 {
 	// For files that are not open, we have to take changes on disk into account,
-	// so we just remove all non-open files.
-
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
-	std::swap(oldRepository, m_fileRepository);
+	// so we start from an empty repository.
+	auto analysis = std::make_shared<Analysis>(
+		FileRepository(_request.fileRepository.basePath(), _request.fileRepository.includePaths()),
+		_request.generation
+	);
+	FileRepository& fileRepository = analysis->fileRepository;
 
 	// Load all solidity files from project.
-	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		for (auto const& projectFile: allSolidityFilesFromProject())
+	if (_request.fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
+		for (auto const& projectFile: allSolidityFilesFromProject(fileRepository.basePath()))
 		{
 			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
-			m_fileRepository.setSourceByUri(
-				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
+			fileRepository.setSourceByUri(
+				fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
 				util::readFileAsString(projectFile)
 			);
 		}
 
 	// Overwrite all files as opened by the client, including the ones which might potentially have changes.
-	for (std::string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByUri(
+	for (std::string const& fileName: _request.openFiles)
+		fileRepository.setSourceByUri(
 			fileName,
-			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
+			_request.fileRepository.sourceUnits().at(_request.fileRepository.uriToSourceUnitName(fileName))
 		);
 
 	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	CompilerStack& compilerStack = *analysis->compilerStack;
+	compilerStack.setSources(fileRepository.sourceUnits());
+	if (compilerStack.parse())
+	{
+		// The analysis cannot be interrupted once started, but we can skip it
+		// if the sources changed again while parsing.
+		if (analysisSuperseded())
+			return nullptr;
+		compilerStack.analyze();
+	}
+
+	return analysis;
+}
+
+bool LanguageServer::analysisSuperseded()
+{
+	std::lock_guard<std::mutex> lock(m_analysisMutex);
+	return m_stopAnalysis || m_pendingAnalysis.has_value();
+}
+
+void LanguageServer::analyseInBackground()
+{
+	while (true)
+	{
+		std::optional<AnalysisRequest> request;
+		{
+			std::unique_lock<std::mutex> lock(m_analysisMutex);
+			m_analysisCondition.wait(lock, [&]() { return m_stopAnalysis || m_pendingAnalysis.has_value(); });
+			if (m_stopAnalysis)
+				return;
+			std::swap(request, m_pendingAnalysis);
+		}
+
+		try
+		{
+			std::shared_ptr<Analysis> analysis;
+			{
+				std::lock_guard<std::mutex> lock(m_yulStringMutex);
+				analysis = analyse(*request);
+			}
+			if (!analysis)
+				continue;
+
+			// Only the pointer is swapped while holding the lock. An analysis the main thread
+			// never picked up is released afterwards.
+			std::shared_ptr<Analysis> previous = analysis;
+			{
+				std::lock_guard<std::mutex> lock(m_analysisMutex);
+				std::swap(previous, m_completedAnalysis);
+			}
+			previous.reset();
+			publishDiagnostics(*analysis);
+		}
+		catch (...)
+		{
+			m_client.error({}, ErrorCode::InternalError, "Unhandled exception during analysis: "s + boost::current_exception_diagnostic_information());
+		}
+	}
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
 {
-	compile();
+	{
+		std::lock_guard<std::mutex> lock(m_analysisMutex);
+		// Replaces any request that was not started yet.
+		m_pendingAnalysis = AnalysisRequest{
+			m_fileRepository,
+			m_openFiles,
+			m_fileLoadStrategy,
+			++m_analysisGeneration
+		};
+	}
+	m_analysisCondition.notify_one();
+}
+
+void LanguageServer::adoptLatestAnalysis()
+{
+	std::shared_ptr<Analysis> analysis;
+	{
+		std::lock_guard<std::mutex> lock(m_analysisMutex);
+		analysis = m_completedAnalysis;
+	}
+	if (!analysis || analysis == m_analysis)
+		return;
+
+	m_analysis = std::move(analysis);
+	if (m_analysis->generation == m_analysisGeneration)
+	{
+		// There were no changes since the analysis was requested, so we can pick up
+		// the files loaded during the analysis (e.g. imports), but keep the current include paths.
+		std::vector<boost::filesystem::path> includePaths = m_fileRepository.includePaths();
+		m_fileRepository = m_analysis->fileRepository;
+		m_fileRepository.setIncludePaths(std::move(includePaths));
+	}
+}
+
+void LanguageServer::publishDiagnostics(Analysis const& _analysis)
+{
+	FileRepository const& fileRepository = _analysis.fileRepository;
+	CompilerStack const& compilerStack = *_analysis.compilerStack;
+
+	auto toRange = [&](SourceLocation const& _location) -> Json::Value {
+		if (!_location.hasText())
+			return toJsonRange({}, {});
+		CharStream const& stream = compilerStack.charStream(*_location.sourceName);
+		return toJsonRange(
+			stream.translatePositionToLineColumn(_location.start),
+			stream.translatePositionToLineColumn(_location.end)
+		);
+	};
 
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
 	std::map<std::string, Json::Value> diagnosticsBySourceUnit;
-	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+	for (std::string const& sourceUnitName: fileRepository.sourceUnits() | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
 	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
 
-	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
+	for (std::shared_ptr<Error const> const& error: compilerStack.errors())
 	{
 		SourceLocation const* location = error->sourceLocation();
 		if (!location || !location->sourceName)
@@ -300,9 +404,11 @@ void LanguageServer::compileAndUpdateDiagnostics()
 		if (auto const* secondary = error->secondarySourceLocation())
 			for (auto&& [secondaryMessage, secondaryLocation]: secondary->infos)
 			{
+				solAssert(secondaryLocation.sourceName);
 				Json::Value jsonRelated;
 				jsonRelated["message"] = secondaryMessage;
-				jsonRelated["location"] = toJson(secondaryLocation);
+				jsonRelated["location"]["uri"] = fileRepository.sourceUnitNameToUri(*secondaryLocation.sourceName);
+				jsonRelated["location"]["range"] = toRange(secondaryLocation);
 				jsonDiag["relatedInformation"].append(jsonRelated);
 			}
 
@@ -320,7 +426,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
 		Json::Value params;
-		params["uri"] = m_fileRepository.sourceUnitNameToUri(sourceUnitName);
+		params["uri"] = fileRepository.sourceUnitNameToUri(sourceUnitName);
 		if (!diagnostics.empty())
 			m_nonemptyDiagnostics.insert(sourceUnitName);
 		params["diagnostics"] = std::move(diagnostics);
@@ -328,44 +434,144 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	}
 }
 
-bool LanguageServer::run()
+void LanguageServer::readMessages()
 {
-	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
+	while (!m_client.closed())
 	{
-		MessageID id;
+		std::optional<Json::Value> jsonMessage;
 		try
 		{
-			std::optional<Json::Value> const jsonMessage = m_client.receive();
-			if (!jsonMessage)
-				continue;
-
-			if ((*jsonMessage)["method"].isString())
-			{
-				std::string const methodName = (*jsonMessage)["method"].asString();
-				id = (*jsonMessage)["id"];
-				lspDebug(fmt::format("received method call: {}", methodName));
-
-				if (auto handler = util::valueOrDefault(m_handlers, methodName))
-					handler(id, (*jsonMessage)["params"]);
-				else
-					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
-			}
-			else
-				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+			jsonMessage = m_client.receive();
 		}
-		catch (Json::Exception const&)
+		catch (...)
 		{
-			m_client.error(id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+			m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 		}
-		catch (RequestError const& error)
+		if (!jsonMessage)
+			continue;
+
+		Json::Value const& method = (*jsonMessage)["method"];
+		if (method == "$/cancelRequest" || method == "cancelRequest")
 		{
-			m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+			// Requests that are already being handled or were answered cannot be cancelled anymore.
+			// Unknown IDs are remembered in case the request itself is read later.
+			Json::Value const& cancelledId = (*jsonMessage)["params"]["id"];
+			if (cancelledId.isNull())
+				continue;
+			std::lock_guard<std::mutex> lock(m_incomingMutex);
+			auto queued = std::find_if(m_incomingMessages.begin(), m_incomingMessages.end(), [&](IncomingMessage const& _queued) {
+				return _queued.message["id"] == cancelledId;
+			});
+			if (queued != m_incomingMessages.end())
+				queued->cancelled = true;
+			else
+				m_cancelledAhead.push_back(cancelledId);
+			continue;
 		}
-		catch (...)
+
+		bool const exitRequested = (method == "exit");
 		{
-			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			std::lock_guard<std::mutex> lock(m_incomingMutex);
+			IncomingMessage incomingMessage{std::move(*jsonMessage)};
+			Json::Value const& id = incomingMessage.message["id"];
+			if (!id.isNull())
+				if (auto cancelled = std::find(m_cancelledAhead.begin(), m_cancelledAhead.end(), id); cancelled != m_cancelledAhead.end())
+				{
+					incomingMessage.cancelled = true;
+					m_cancelledAhead.erase(cancelled);
+				}
+			m_incomingMessages.push_back(std::move(incomingMessage));
 		}
+		m_incomingCondition.notify_one();
+		if (exitRequested)
+			break;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_incomingMutex);
+		m_inputFinished = true;
 	}
+	m_incomingCondition.notify_one();
+}
+
+std::optional<LanguageServer::IncomingMessage> LanguageServer::nextMessage()
+{
+	std::unique_lock<std::mutex> lock(m_incomingMutex);
+	m_incomingCondition.wait(lock, [&]() { return m_inputFinished || !m_incomingMessages.empty(); });
+	if (m_incomingMessages.empty())
+		return std::nullopt;
+
+	IncomingMessage message = std::move(m_incomingMessages.front());
+	m_incomingMessages.pop_front();
+	if (m_incomingMessages.empty())
+		// Cancellations of requests that were answered before they were cancelled have no effect.
+		m_cancelledAhead.clear();
+	return message;
+}
+
+void LanguageServer::handleMessage(IncomingMessage const& _message)
+{
+	Json::Value const& jsonMessage = _message.message;
+	MessageID id;
+	try
+	{
+		if (jsonMessage["method"].isString())
+		{
+			std::string const methodName = jsonMessage["method"].asString();
+			id = jsonMessage["id"];
+			lspDebug(fmt::format("received method call: {}", methodName));
+
+			if (_message.cancelled && !id.isNull())
+				m_client.error(id, ErrorCode::RequestCancelled, "Request cancelled.");
+			else if (auto handler = util::valueOrDefault(m_handlers, methodName))
+				handler(id, jsonMessage["params"]);
+			else
+				m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
+		}
+		else
+			m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+	}
+	catch (Json::Exception const&)
+	{
+		m_client.error(id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+	}
+	catch (RequestError const& error)
+	{
+		m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+	}
+	catch (...)
+	{
+		m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+	}
+}
+
+bool LanguageServer::run()
+{
+	std::thread reader(&LanguageServer::readMessages, this);
+	std::thread analyser(&LanguageServer::analyseInBackground, this);
+
+	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown)
+	{
+		std::optional<IncomingMessage> message = nextMessage();
+		if (!message)
+			break;
+		adoptLatestAnalysis();
+		TypeProvider::Scope typeProviderScope(m_analysis->typeProvider);
+		std::unique_lock<std::mutex> yulStringLock(m_yulStringMutex, std::defer_lock);
+		// Renaming reads the names of identifiers in inline assembly.
+		if (message->message["method"] == "textDocument/rename")
+			yulStringLock.lock();
+		handleMessage(*message);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_analysisMutex);
+		m_stopAnalysis = true;
+	}
+	m_analysisCondition.notify_one();
+	analyser.join();
+	reader.join();
+
 	return m_state == State::ExitRequested;
 }
 
@@ -437,12 +643,20 @@ void LanguageServer::semanticTokensFull(MessageID _id, Json::Value const& _args)
 {
 	auto uri = _args["textDocument"]["uri"];
 
-	compile();
+	// Served from the last completed analysis, which might not include the file yet.
+	CompilerStack const& compilerStack = *m_analysis->compilerStack;
+	auto const sourceName = m_analysis->fileRepository.uriToSourceUnitName(uri.as<std::string>());
+	if (
+		compilerStack.state() < CompilerStack::Parsed ||
+		!m_analysis->fileRepository.sourceUnits().count(sourceName)
+	)
+	{
+		m_client.reply(_id, Json::nullValue);
+		return;
+	}
 
-	auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.as<std::string>());
-	SourceUnit const& ast = m_compilerStack.ast(sourceName);
-	m_compilerStack.charStream(sourceName);
-	Json::Value data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+	SourceUnit const& ast = compilerStack.ast(sourceName);
+	Json::Value data = SemanticTokensBuilder().build(ast, compilerStack.charStream(sourceName));
 
 	Json::Value reply = Json::objectValue;
 	reply["data"] = data;
@@ -554,14 +768,15 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+	CompilerStack const& compilerStack = *m_analysis->compilerStack;
+	if (compilerStack.state() < CompilerStack::AnalysisSuccessful)
 		return {nullptr, -1};
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
+	if (!m_analysis->fileRepository.sourceUnits().count(_sourceUnitName))
 		return {nullptr, -1};
 
-	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
+	std::optional<int> sourcePos = compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	return {locateInnermostASTNode(*sourcePos, compilerStack.ast(_sourceUnitName)), *sourcePos};
 }
@@ -19,14 +19,20 @@
 
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
 #include <json/value.h>
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -64,13 +70,15 @@ public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
 
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
+	/// Requests a re-compilation of the project, which is performed by a background thread
+	/// that updates the diagnostics pushed to the client once it is finished.
+	/// Requests that arrive while an analysis is still running are coalesced into one.
+	/// Messages are handled while an analysis is running, using the last completed one.
 	void compileAndUpdateDiagnostics();
 
-	/// Loops over incoming messages via the transport layer until shutdown condition is met.
-	///
-	/// The standard shutdown condition is when the maximum number of consecutive failures
-	/// has been exceeded.
+	/// Loops over incoming messages until shutdown condition is met.
+	/// Messages are read from the transport layer by a separate thread, so that
+	/// requests can be cancelled before they are handled.
 	///
 	/// @return boolean indicating normal or abnormal termination.
 	bool run();
@@ -79,9 +87,62 @@ public:
 	Transport& client() noexcept { return m_client; }
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
-	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	/// @returns the compiler stack of the analysis that was the last completed one
+	/// when the handling of the current message started.
+	frontend::CompilerStack const& compilerStack() const noexcept { return *m_analysis->compilerStack; }
 
 private:
+	/// The source units together with the result of analysing them. Every analysis has its own
+	/// type provider, so that the next analysis can run while this one is used to handle messages.
+	/// Not modified anymore once the analysis is completed.
+	struct Analysis
+	{
+		Analysis(FileRepository _fileRepository, size_t _generation);
+
+		/// Declared first, so that it outlives the types used by the compiler stack.
+		frontend::TypeProvider typeProvider;
+		FileRepository fileRepository;
+		std::unique_ptr<frontend::CompilerStack> compilerStack;
+		/// Number of the request the analysis was performed for.
+		size_t generation;
+	};
+
+	/// Input of an analysis, captured at the time the analysis was requested.
+	struct AnalysisRequest
+	{
+		FileRepository fileRepository;
+		std::set<std::string> openFiles;
+		FileLoadStrategy fileLoadStrategy;
+		size_t generation;
+	};
+
+	struct IncomingMessage
+	{
+		Json::Value message;
+		/// True if the client cancelled the request before it was handled.
+		bool cancelled = false;
+	};
+
+	/// Reads messages from the transport layer until the input is closed or
+	/// the exit notification is received. Runs on its own thread.
+	void readMessages();
+	/// Waits for the next message read by @a readMessages.
+	/// @returns std::nullopt if there will be no further messages.
+	std::optional<IncomingMessage> nextMessage();
+	void handleMessage(IncomingMessage const& _message);
+
+	/// Performs the requested analyses one after another. Runs on its own thread.
+	void analyseInBackground();
+	/// Compile everything until after analysis phase.
+	/// @returns nullptr if a newer analysis was requested in the meantime.
+	std::shared_ptr<Analysis> analyse(AnalysisRequest const& _request);
+	/// @returns true if the analysis currently running is outdated.
+	bool analysisSuperseded();
+	void publishDiagnostics(Analysis const& _analysis);
+	/// Switches to the last completed analysis and picks up the files it loaded
+	/// if nothing changed since it was requested.
+	void adoptLatestAnalysis();
+
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
 	void requireServerInitialized();
@@ -99,16 +160,10 @@ private:
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json::Value const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
-
-	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
+	static std::vector<boost::filesystem::path> allSolidityFilesFromProject(boost::filesystem::path const& _basePath);
 
 	using MessageHandler = std::function<void(MessageID, Json::Value const&)>;
 
-	Json::Value toRange(langutil::SourceLocation const& _location);
-	Json::Value toJson(langutil::SourceLocation const& _location);
-
 	// LSP related member fields
 
 	enum class State { Started, Initialized, ShutdownRequested, ExitRequested, ExitWithoutShutdown };
@@ -119,15 +174,41 @@ private:
 
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
-	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
-	std::set<std::string> m_nonemptyDiagnostics;
 	FileRepository m_fileRepository;
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
-	frontend::CompilerStack m_compilerStack;
-
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
+
+	/// Analysis used to handle the current message. Only accessed by the main thread.
+	std::shared_ptr<Analysis> m_analysis;
+	/// Number of the most recently requested analysis. Only accessed by the main thread.
+	size_t m_analysisGeneration = 0;
+	/// Held by the analysis thread while it analyses and by the main thread while handling messages
+	/// that read Yul strings. These are added to a global repository while parsing inline assembly,
+	/// which must not be read by another thread at the same time.
+	std::mutex m_yulStringMutex;
+
+	std::mutex m_incomingMutex;
+	std::condition_variable m_incomingCondition;
+	/// Messages read from the transport layer that were not yet handled.
+	std::deque<IncomingMessage> m_incomingMessages;
+	/// IDs of cancelled requests that were not read yet.
+	std::vector<Json::Value> m_cancelledAhead;
+	/// Set once no further messages will be read.
+	bool m_inputFinished = false;
+
+	std::mutex m_analysisMutex;
+	std::condition_variable m_analysisCondition;
+	/// Most recent analysis request that was not yet started.
+	std::optional<AnalysisRequest> m_pendingAnalysis;
+	/// Last completed analysis, picked up by the main thread before handling a message.
+	std::shared_ptr<Analysis> m_completedAnalysis;
+	bool m_stopAnalysis = false;
+
+	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
+	/// Only accessed by the analysis thread.
+	std::set<std::string> m_nonemptyDiagnostics;
 };
 
 }
@@ -68,7 +68,7 @@ void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 	extractNameAndDeclaration(*sourceNode, *cursorBytePosition);
 
 	// Find all source units using this symbol
-	for (auto const& [name, content]: fileRepository().sourceUnits())
+	for (std::string const& name: m_server.compilerStack().sourceNames())
 	{
 		auto const& sourceUnit = m_server.compilerStack().ast(name);
 		for (auto const* referencedSourceUnit: sourceUnit.referencedSourceUnits(true, util::convertContainer<std::set<SourceUnit const*>>(m_sourceUnits)))
@@ -21,9 +21,11 @@
 
 #include <json/value.h>
 
+#include <atomic>
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -51,6 +53,7 @@ enum class ErrorCode
 
 	// Defined by the protocol.
 	ServerNotInitialized = -32002,
+	RequestCancelled = -32800,
 	RequestFailed = -32803
 };
 
@@ -92,6 +95,9 @@ private:
  *
  * The transport layer API is abstracted to make LSP more testable as well as
  * this way it could be possible to support other transports (HTTP for example) easily.
+ *
+ * Messages can be sent from multiple threads concurrently, while receiving is
+ * restricted to a single thread.
  */
 class Transport
 {
@@ -111,7 +117,9 @@ public:
 	void setTrace(TraceValue _value) noexcept { m_logTrace = _value; }
 
 private:
-	TraceValue m_logTrace = TraceValue::Off;
+	std::atomic<TraceValue> m_logTrace{TraceValue::Off};
+	/// Serializes writing complete messages.
+	std::mutex m_sendMutex;
 
 protected:
 	/// Reads from the transport and parses the headers until the beginning
@@ -49,12 +49,18 @@ using bigint = boost::multiprecision::number<boost::multiprecision::cpp_int_back
 using u256 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<256, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
 using s256 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<256, 256, boost::multiprecision::signed_magnitude, boost::multiprecision::unchecked, void>>;
 
+/// Fixed-width type wide enough to hold the full product of two u256 values.
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 512, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
+
+// The functions below operate on fixed-width types only and do not allocate,
+// which makes them suitable for the constant folding hot paths of the optimizers.
+
 /// Interprets @a _u as a two's complement signed number and returns the resulting s256.
 inline s256 u2s(u256 _u)
 {
-	static bigint const c_end = bigint(1) << 256;
 	if (boost::multiprecision::bit_test(_u, 255))
-		return s256(-(c_end - _u));
+		// The magnitude 2**256 - _u is at most 2**255, so it cannot overflow.
+		return -s256(u256(~_u + 1));
 	else
 		return s256(_u);
 }
@@ -62,11 +68,10 @@ inline s256 u2s(u256 _u)
 /// @returns the two's complement signed representation of the signed number _u.
 inline u256 s2u(s256 _u)
 {
-	static bigint const c_end = bigint(1) << 256;
 	if (_u >= 0)
 		return u256(_u);
 	else
-		return u256(c_end + _u);
+		return ~u256(-_u) + 1;
 }
 
 inline u256 exp256(u256 _base, u256 _exponent)
@@ -83,6 +88,20 @@ inline u256 exp256(u256 _base, u256 _exponent)
 	return result;
 }
 
+/// @returns (_a + _b) % _modulus computed without intermediate overflow, i.e. the EVM's ADDMOD.
+/// @a _modulus must not be zero.
+inline u256 addmod256(u256 const& _a, u256 const& _b, u256 const& _modulus)
+{
+	return u256((u512(_a) + u512(_b)) % u512(_modulus));
+}
+
+/// @returns (_a * _b) % _modulus computed without intermediate overflow, i.e. the EVM's MULMOD.
+/// @a _modulus must not be zero.
+inline u256 mulmod256(u256 const& _a, u256 const& _b, u256 const& _modulus)
+{
+	return u256((u512(_a) * u512(_b)) % u512(_modulus));
+}
+
 /// Checks whether _mantissa * (X ** _exp) fits into 4096 bits,
 /// where X is given indirectly via _log2OfBase = log2(X).
 bool fitsPrecisionBaseX(bigint const& _mantissa, double _log2OfBase, uint32_t _exp);
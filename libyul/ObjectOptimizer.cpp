@@ -0,0 +1,143 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/ObjectOptimizer.h>
+
+#include <libyul/AST.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Exceptions.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/FunctionCache.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <solidity/BuildInfo.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <typeinfo>
+
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+void ObjectOptimizer::optimize(Object& _object, Dialect const& _dialect, Settings const& _settings, bool _isCreation)
+{
+	optimizeObject(_object, _dialect, _settings, _isCreation);
+}
+
+std::shared_ptr<ObjectOptimizer::CachedObject const> ObjectOptimizer::optimizeObject(
+	Object& _object,
+	Dialect const& _dialect,
+	Settings const& _settings,
+	bool _isCreation
+)
+{
+	yulAssert(_object.code, "");
+	yulAssert(_object.analysisInfo, "");
+
+	// The key has to be computed before the sub-objects are optimized.
+	h256 hash = keccak256(
+		std::to_string(_settings.optimizeStackAllocation) + ":" +
+		_settings.yulOptimiserSteps + ":" +
+		_settings.yulOptimiserCleanupSteps + ":" +
+		std::to_string(_settings.expectedExecutionsPerDeployment) + ":" +
+		std::to_string(_isCreation) + ":" +
+		std::to_string(_settings.isolatedFunctionOptimization) + ":" +
+		_settings.functionCacheDirectory + ":" +
+		_object.toString(&_dialect, DebugInfoSelection::All())
+	);
+	std::tuple<Dialect const*, h256> key{&_dialect, hash};
+	if (auto const* cachedObject = util::valueOrNullptr(m_cachedObjects, key))
+	{
+		restore(_object, **cachedObject, _dialect);
+		++m_reusedObjectCount;
+		return *cachedObject;
+	}
+
+	auto result = std::make_shared<CachedObject>();
+	for (auto& subNode: _object.subObjects)
+		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+		{
+			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
+			result->subObjects.emplace_back(optimizeObject(*subObject, _dialect, _settings, isCreation));
+		}
+
+	std::unique_ptr<GasMeter> meter;
+	std::unique_ptr<FunctionCache> functionCache;
+	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
+	{
+		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, _settings.expectedExecutionsPerDeployment);
+		// The cache is shared between compiler runs, so the key has to include the compiler version.
+		// Builds from modified sources with the same version string share their entries, which is
+		// documented for the command line option.
+		if (_settings.isolatedFunctionOptimization)
+			functionCache = std::make_unique<FunctionCache>(
+				_settings.functionCacheDirectory,
+				std::string(ETH_PROJECT_VERSION ":" SOL_VERSION_PRERELEASE ":" SOL_VERSION_BUILDINFO ":") +
+				typeid(*evmDialect).name() + ":" +
+				evmDialect->evmVersion().name() + ":" +
+				std::to_string(evmDialect->providesObjectAccess()) + ":" +
+				std::to_string(_settings.optimizeStackAllocation) + ":" +
+				_settings.yulOptimiserSteps + ":" +
+				_settings.yulOptimiserCleanupSteps + ":" +
+				std::to_string(_settings.expectedExecutionsPerDeployment) + ":" +
+				std::to_string(_isCreation)
+			);
+	}
+
+	OptimiserSuite::run(
+		_dialect,
+		meter.get(),
+		_object,
+		// Defaults are the minimum necessary to avoid running into "Stack too deep" constantly.
+		_settings.optimizeStackAllocation,
+		_settings.yulOptimiserSteps,
+		_settings.yulOptimiserCleanupSteps,
+		_isCreation ? std::nullopt : std::make_optional(_settings.expectedExecutionsPerDeployment),
+		{},
+		functionCache.get()
+	);
+	if (functionCache)
+		m_reusedFunctionCount += functionCache->reusedFunctionCount();
+
+	// Store a copy, since the optimized object may still be modified by its owner.
+	result->code = std::make_shared<Block>(std::get<Block>(ASTCopier{}(*_object.code)));
+	m_cachedObjects[key] = result;
+	return result;
+}
+
+void ObjectOptimizer::restore(Object& _object, CachedObject const& _cachedObject, Dialect const& _dialect)
+{
+	_object.code = std::make_shared<Block>(std::get<Block>(ASTCopier{}(*_cachedObject.code)));
+	size_t subObjectIndex = 0;
+	for (auto& subNode: _object.subObjects)
+		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			restore(*subObject, *_cachedObject.subObjects.at(subObjectIndex++), _dialect);
+	yulAssert(subObjectIndex == _cachedObject.subObjects.size(), "");
+	// Provide the same analysis information as the optimizer suite does after optimization.
+	_object.analysisInfo = std::make_shared<AsmAnalysisInfo>(AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object));
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimization of Yul objects and their sub-objects, sharing the results
+ * between identical objects.
+ */
+
+#pragma once
+
+#include <libyul/Object.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Runs the optimizer suite on a Yul object and all its sub-objects.
+ *
+ * The optimization of an object only depends on its own code, its sub-objects, the dialect and the
+ * settings. An instance therefore remembers the result of each object it optimized, keyed by a hash of
+ * the unoptimized object (printed with all debug information, including its sub-objects) and the settings.
+ * Optimizing an identical object again, e.g. the object of a contract that is also embedded into the
+ * objects of all contracts that create it, copies the stored result instead of running the optimizer.
+ *
+ * Only the native source locations of the stored result refer to the source of the object that was
+ * optimized first, all other parts of the result are the same as when running the optimizer.
+ */
+class ObjectOptimizer
+{
+public:
+	struct Settings
+	{
+		bool optimizeStackAllocation = false;
+		std::string yulOptimiserSteps;
+		std::string yulOptimiserCleanupSteps;
+		size_t expectedExecutionsPerDeployment = 0;
+		/// If set, self-contained top-level functions are optimized in isolation using a FunctionCache.
+		bool isolatedFunctionOptimization = false;
+		/// If not empty, the directory the FunctionCache stores its results in.
+		std::string functionCacheDirectory;
+	};
+
+	/// Optimizes @a _object and its sub-objects in place. @a _isCreation is used for the gas estimation
+	/// of @a _object, sub-objects are considered to be creation code unless their name ends in "_deployed".
+	void optimize(Object& _object, Dialect const& _dialect, Settings const& _settings, bool _isCreation);
+
+	/// @returns the number of objects that were copied from earlier results instead of being optimized.
+	size_t reusedObjectCount() const { return m_reusedObjectCount; }
+	/// @returns the number of functions that were taken from the function cache.
+	size_t reusedFunctionCount() const { return m_reusedFunctionCount; }
+
+private:
+	/// The optimized code of an object and (in order) the ones of its sub-objects that are no data objects.
+	struct CachedObject
+	{
+		std::shared_ptr<Block const> code;
+		std::vector<std::shared_ptr<CachedObject const>> subObjects;
+	};
+
+	/// Optimizes @a _object and its sub-objects unless an identical object has been optimized before.
+	/// @returns the stored result.
+	std::shared_ptr<CachedObject const> optimizeObject(
+		Object& _object,
+		Dialect const& _dialect,
+		Settings const& _settings,
+		bool _isCreation
+	);
+	/// Replaces the code of @a _object and its sub-objects by copies of the code stored in @a _cachedObject.
+	static void restore(Object& _object, CachedObject const& _cachedObject, Dialect const& _dialect);
+
+	std::map<std::tuple<Dialect const*, util::h256>, std::shared_ptr<CachedObject const>> m_cachedObjects;
+	size_t m_reusedObjectCount = 0;
+	size_t m_reusedFunctionCount = 0;
+};
+
+}
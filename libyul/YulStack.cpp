@@ -28,7 +28,6 @@
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMObjectCompiler.h>
-#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/Suite.h>
@@ -36,8 +35,6 @@
 #include <liblangutil/Scanner.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 
-#include <boost/algorithm/string.hpp>
-
 #include <optional>
 
 using namespace solidity;
@@ -99,7 +96,36 @@ void YulStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
+
+	ObjectOptimizer::Settings settings = [&]() -> ObjectOptimizer::Settings
+	{
+		if (!m_optimiserSettings.runYulOptimiser)
+		{
+			// Yul optimizer disabled, but empty sequence (:) explicitly provided
+			if (OptimiserSuite::isEmptyOptimizerSequence(m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps))
+				return {true, "", "", m_optimiserSettings.expectedExecutionsPerDeployment, false, ""};
+			// Yul optimizer disabled, and no sequence explicitly provided (assumes default sequence)
+			else
+			{
+				yulAssert(
+					m_optimiserSettings.yulOptimiserSteps == OptimiserSettings::DefaultYulOptimiserSteps &&
+					m_optimiserSettings.yulOptimiserCleanupSteps == OptimiserSettings::DefaultYulOptimiserCleanupSteps
+				);
+				return {true, "u", "", m_optimiserSettings.expectedExecutionsPerDeployment, false, ""};
+			}
+
+		}
+		return {
+			m_optimiserSettings.optimizeStackAllocation,
+			m_optimiserSettings.yulOptimiserSteps,
+			m_optimiserSettings.yulOptimiserCleanupSteps,
+			m_optimiserSettings.expectedExecutionsPerDeployment,
+			m_optimiserSettings.isolatedFunctionOptimization,
+			m_optimiserSettings.yulFunctionCacheDirectory
+		};
+	}();
+
+	m_objectOptimizer->optimize(*m_parserResult, languageToDialect(m_language, m_evmVersion), settings, true);
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
@@ -147,60 +173,14 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
-}
-
-void YulStack::optimize(Object& _object, bool _isCreation)
-{
-	yulAssert(_object.code, "");
-	yulAssert(_object.analysisInfo, "");
-	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-		{
-			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			optimize(*subObject, isCreation);
-		}
-
-	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
-	std::unique_ptr<GasMeter> meter;
-	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
-		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
-
-	auto [optimizeStackAllocation, yulOptimiserSteps, yulOptimiserCleanupSteps] = [&]() -> std::tuple<bool, std::string, std::string>
-	{
-		if (!m_optimiserSettings.runYulOptimiser)
-		{
-			// Yul optimizer disabled, but empty sequence (:) explicitly provided
-			if (OptimiserSuite::isEmptyOptimizerSequence(m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps))
-				return std::make_tuple(true, "", "");
-			// Yul optimizer disabled, and no sequence explicitly provided (assumes default sequence)
-			else
-			{
-				yulAssert(
-					m_optimiserSettings.yulOptimiserSteps == OptimiserSettings::DefaultYulOptimiserSteps &&
-					m_optimiserSettings.yulOptimiserCleanupSteps == OptimiserSettings::DefaultYulOptimiserCleanupSteps
-				);
-				return std::make_tuple(true, "u", "");
-			}
-
-		}
-		return std::make_tuple(
-			m_optimiserSettings.optimizeStackAllocation,
-			m_optimiserSettings.yulOptimiserSteps,
-			m_optimiserSettings.yulOptimiserCleanupSteps
-		);
-	}();
-
-	OptimiserSuite::run(
-		dialect,
-		meter.get(),
-		_object,
-		// Defaults are the minimum necessary to avoid running into "Stack too deep" constantly.
-		optimizeStackAllocation,
-		yulOptimiserSteps,
-		yulOptimiserCleanupSteps,
-		_isCreation ? std::nullopt : std::make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_optimize,
+		m_eofVersion,
+		m_optimiserSettings.outlineColdBlocks,
+		m_optimiserSettings.eliminateTailCalls
 	);
 }
 
@@ -227,6 +207,8 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName) cons
 	yulAssert(creationAssembly, "");
 	yulAssert(m_charStream, "");
 
+	std::map<std::string, unsigned> const sourceIndices{{m_charStream->name(), 0}};
+
 	MachineAssemblyObject creationObject;
 	creationObject.bytecode = std::make_shared<evmasm::LinkerObject>(creationAssembly->assemble());
 	yulAssert(creationObject.bytecode->immutableReferences.empty(), "Leftover immutables.");
@@ -234,7 +216,7 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName) cons
 	creationObject.sourceMappings = std::make_unique<std::string>(
 		evmasm::AssemblyItem::computeSourceMapping(
 			creationAssembly->items(),
-			{{m_charStream->name(), 0}}
+			sourceIndices
 		)
 	);
 
@@ -246,7 +228,7 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName) cons
 		deployedObject.sourceMappings = std::make_unique<std::string>(
 			evmasm::AssemblyItem::computeSourceMapping(
 				deployedAssembly->items(),
-				{{m_charStream->name(), 0}}
+				sourceIndices
 			)
 		);
 	}
@@ -262,8 +244,8 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName) c
 	yulAssert(m_parserResult->code, "");
 	yulAssert(m_parserResult->analysisInfo, "");
 
-	evmasm::Assembly assembly(m_evmVersion, true, {});
-	EthAssemblyAdapter adapter(assembly);
+	auto assembly = std::make_shared<evmasm::Assembly>(m_evmVersion, true, m_eofVersion, std::string{});
+	EthAssemblyAdapter adapter(*assembly);
 
 	// NOTE: We always need stack optimization when Yul optimizer is disabled (unless code contains
 	// msize). It being disabled just means that we don't use the full step sequence. We still run
@@ -274,15 +256,16 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName) c
 	);
 	compileEVM(adapter, optimize);
 
-	assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+	assembly->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+	assembly->setCompactJumpTags(m_optimiserSettings.compactJumpTags);
 
 	std::optional<size_t> subIndex;
 
 	// Pick matching assembly if name was given
 	if (_deployName.has_value())
 	{
-		for (size_t i = 0; i < assembly.numSubs(); i++)
-			if (assembly.sub(i).name() == _deployName)
+		for (size_t i = 0; i < assembly->numSubs(); i++)
+			if (assembly->sub(i).name() == _deployName)
 			{
 				subIndex = i;
 				break;
@@ -291,16 +274,14 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName) c
 		solAssert(subIndex.has_value(), "Failed to find object to be deployed.");
 	}
 	// Otherwise use heuristic: If there is a single sub-assembly, this is likely the object to be deployed.
-	else if (assembly.numSubs() == 1)
+	else if (assembly->numSubs() == 1)
 		subIndex = 0;
 
+	// The runtime assembly is shared with the creation assembly, so that it is only assembled once.
 	if (subIndex.has_value())
-	{
-		evmasm::Assembly& runtimeAssembly = assembly.sub(*subIndex);
-		return {std::make_shared<evmasm::Assembly>(assembly), std::make_shared<evmasm::Assembly>(runtimeAssembly)};
-	}
+		return {assembly, assembly->subPointer(*subIndex)};
 
-	return {std::make_shared<evmasm::Assembly>(assembly), {}};
+	return {assembly, {}};
 }
 
 std::string YulStack::print(
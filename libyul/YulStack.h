@@ -27,6 +27,7 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <libyul/Object.h>
+#include <libyul/ObjectOptimizer.h>
 #include <libyul/ObjectParser.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -79,19 +80,23 @@ public:
 		)
 	{}
 
+	/// @param _objectOptimizer optimizer shared with other stacks, so that objects that were already optimized
+	/// by one of them are not optimized again. If null, the stack uses its own optimizer.
 	YulStack(
 		langutil::EVMVersion _evmVersion,
 		std::optional<uint8_t> _eofVersion,
 		Language _language,
 		solidity::frontend::OptimiserSettings _optimiserSettings,
-		langutil::DebugInfoSelection const& _debugInfoSelection
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		std::shared_ptr<ObjectOptimizer> _objectOptimizer = nullptr
 	):
 		m_language(_language),
 		m_evmVersion(_evmVersion),
 		m_eofVersion(_eofVersion),
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_debugInfoSelection(_debugInfoSelection),
-		m_errorReporter(m_errors)
+		m_errorReporter(m_errors),
+		m_objectOptimizer(_objectOptimizer ? std::move(_objectOptimizer) : std::make_shared<ObjectOptimizer>())
 	{}
 
 	/// @returns the char stream used during parsing
@@ -142,8 +147,6 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
-
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
@@ -158,6 +161,8 @@ private:
 	langutil::ErrorReporter m_errorReporter;
 
 	std::unique_ptr<std::string> m_sourceMappings;
+
+	std::shared_ptr<ObjectOptimizer> m_objectOptimizer;
 };
 
 }
@@ -25,6 +25,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 #include <functional>
@@ -66,6 +67,19 @@ public:
 
 		return Handle{id, h};
 	}
+	/// @returns the handle of @a _string if it has already been added to the repository.
+	/// In contrast to stringToHandle, this never adds a new string.
+	std::optional<Handle> findHandle(std::string const& _string) const
+	{
+		if (_string.empty())
+			return Handle{0, emptyHash()};
+		std::uint64_t h = hash(_string);
+		auto range = m_hashToID.equal_range(h);
+		for (auto it = range.first; it != range.second; ++it)
+			if (*m_strings[it->second] == _string)
+				return Handle{it->second, h};
+		return std::nullopt;
+	}
 	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
@@ -132,6 +146,16 @@ public:
 	YulString& operator=(YulString const&) = default;
 	YulString& operator=(YulString&&) = default;
 
+	/// @returns the YulString for @a _s if it is already known to the repository and
+	/// nullopt otherwise. Can be used to check for membership in containers of YulStrings
+	/// without adding the string to the repository.
+	static std::optional<YulString> find(std::string const& _s)
+	{
+		if (auto handle = YulStringRepository::instance().findHandle(_s))
+			return YulString{*handle};
+		return std::nullopt;
+	}
+
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
 	/// it checks for identical IDs (only identical strings have
@@ -158,6 +182,8 @@ public:
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
+	explicit YulString(YulStringRepository::Handle _handle): m_handle(_handle) {}
+
 	/// Handle of the string. Assumes that the empty string has ID zero.
 	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
 };
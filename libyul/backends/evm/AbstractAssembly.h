@@ -56,6 +56,7 @@ class AbstractAssembly
 public:
 	using LabelID = size_t;
 	using SubID = size_t;
+	using FunctionID = uint16_t;
 	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
 
 	virtual ~AbstractAssembly() = default;
@@ -96,6 +97,18 @@ public:
 	/// Append a jump-to-if-immediate operation.
 	virtual void appendJumpToIf(LabelID _labelId, JumpType _jumpType = JumpType::Ordinary) = 0;
 
+	/// Registers a new function taking @a _arguments and returning @a _returns stack items,
+	/// which is compiled into its own code section. Only available in EOF.
+	virtual FunctionID registerFunction(uint8_t _arguments, uint8_t _returns) = 0;
+	/// Directs all following code to the code section of the function @a _functionID
+	/// until ``endFunction`` is called. Only available in EOF.
+	virtual void beginFunction(FunctionID _functionID) = 0;
+	virtual void endFunction() = 0;
+	/// Append a call (CALLF) of the function @a _functionID. Only available in EOF.
+	virtual void appendFunctionCall(FunctionID _functionID) = 0;
+	/// Append a return (RETF) from the current function. Only available in EOF.
+	virtual void appendFunctionReturn() = 0;
+
 	/// Append the assembled size as a constant.
 	virtual void appendAssemblySize() = 0;
 	/// Creates a new sub-assembly, which can be referenced using dataSize and dataOffset.
@@ -120,6 +133,8 @@ public:
 
 	/// @returns the EVM version the assembly targets.
 	virtual langutil::EVMVersion evmVersion() const = 0;
+	/// @returns the EOF version the assembly targets, if any.
+	virtual std::optional<uint8_t> eofVersion() const = 0;
 };
 
 enum class IdentifierContext { LValue, RValue, VariableDeclaration, NonExternal };
@@ -140,15 +140,16 @@ Representation const& RepresentationFinder::findRepresentation(u256 const& _valu
 
 		u256 powerOfTwo = u256(1) << bits;
 		u256 upperPart = _value >> bits;
-		bigint lowerPart = _value & (powerOfTwo - 1);
-		if ((powerOfTwo - lowerPart) < lowerPart)
+		// The magnitudes involved are below 2**256, so the fixed-width s256 suffices.
+		s256 lowerPart = s256(_value & (powerOfTwo - 1));
+		if ((s256(powerOfTwo) - lowerPart) < lowerPart)
 		{
-			lowerPart = lowerPart - powerOfTwo; // make it negative
+			lowerPart = lowerPart - s256(powerOfTwo); // make it negative
 			upperPart++;
 		}
 		if (upperPart == 0)
 			continue;
-		if (abs(lowerPart) >= (powerOfTwo >> 8))
+		if (abs(lowerPart) >= s256(powerOfTwo >> 8))
 			continue;
 		Representation newRoutine;
 		if (m_dialect.evmVersion().hasBitwiseShifting())
@@ -150,6 +150,9 @@ struct CFG
 		bool recursive = false;
 		/// True, if the call can return.
 		bool canContinue = true;
+		/// True, if the call is in tail position and jumps to the callee with the return label of the calling
+		/// function instead of a fresh return label. The block of such a call ends with ``Terminated``.
+		bool tailCall = false;
 	};
 	struct Assignment
 	{
@@ -218,6 +221,8 @@ struct CFG
 		std::vector<VariableSlot> returnVariables;
 		std::vector<BasicBlock*> exits;
 		bool canContinue = true;
+		/// True, if the function has a reachable branch that terminates successfully.
+		bool canTerminate = true;
 	};
 
 	/// The main entry point, i.e. the start of the outermost Yul block.
@@ -226,6 +231,10 @@ struct CFG
 	std::map<Scope::Function const*, FunctionInfo> functionInfo;
 	/// List of functions in order of declaration.
 	std::list<Scope::Function const*> functions;
+	/// If true, function calls and returns are implemented as jumps, s.t. the caller passes a return label
+	/// to the callee (see ``FunctionCallReturnLabelSlot``). Otherwise, functions are called and returned from
+	/// by dedicated instructions (CALLF and RETF in EOF) and there are no return label slots.
+	bool simulateFunctionsWithJumps = true;
 
 	/// Container for blocks for explicit ownership.
 	std::list<BasicBlock> blocks;
@@ -126,6 +126,54 @@ void markRecursiveCalls(CFG& _cfg)
 		}
 }
 
+/// Turns calls in tail position of a function into tail calls, i.e. for each function return of a function
+/// that is immediately preceded by a call whose return values are exactly assigned to the return variables
+/// of the function (or if neither function has return values), the call is made to directly return to the
+/// caller of the current function. This saves pushing a return label, the jump back and the final shuffling.
+/// The affected blocks remain listed as function exits, so they still require a clean stack.
+void markTailCalls(CFG& _cfg)
+{
+	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
+		for (CFG::BasicBlock* exit: functionInfo.exits)
+		{
+			if (!std::holds_alternative<CFG::BasicBlock::FunctionReturn>(exit->exit))
+				continue;
+			auto& operations = exit->operations;
+			if (operations.empty())
+				continue;
+
+			CFG::Operation* assignment = nullptr;
+			CFG::Operation* call = &operations.back();
+			if (std::holds_alternative<CFG::Assignment>(call->operation))
+			{
+				if (operations.size() < 2)
+					continue;
+				assignment = call;
+				call = &operations.at(operations.size() - 2);
+			}
+			auto* functionCall = std::get_if<CFG::FunctionCall>(&call->operation);
+			if (!functionCall || !functionCall->canContinue)
+				continue;
+			if (assignment)
+			{
+				auto const& assignedVariables = std::get<CFG::Assignment>(assignment->operation).variables;
+				if (assignment->input != call->output || assignedVariables != functionInfo.returnVariables)
+					continue;
+			}
+			else if (!functionInfo.returnVariables.empty() || !call->output.empty())
+				continue;
+
+			// The return label of the call is the first input slot.
+			yulAssert(!call->input.empty());
+			yulAssert(std::holds_alternative<FunctionCallReturnLabelSlot>(call->input.front()));
+			call->input.front() = FunctionReturnLabelSlot{functionInfo.function};
+			functionCall->tailCall = true;
+			if (assignment)
+				operations.pop_back();
+			exit->exit = CFG::BasicBlock::Terminated{};
+		}
+}
+
 /// Marks each cut-vertex in the CFG, i.e. each block that begins a disconnected sub-graph of the CFG.
 /// Entering such a block means that control flow will never return to a previously visited block.
 void markStartsOfSubGraphs(CFG& _cfg)
@@ -208,11 +256,15 @@ void markNeedsCleanStack(CFG& _cfg)
 std::unique_ptr<CFG> ControlFlowGraphBuilder::build(
 	AsmAnalysisInfo const& _analysisInfo,
 	Dialect const& _dialect,
-	Block const& _block
+	Block const& _block,
+	bool _eliminateTailCalls,
+	bool _simulateFunctionsWithJumps
 )
 {
+	yulAssert(!_eliminateTailCalls || _simulateFunctionsWithJumps, "Tail calls can only be eliminated if functions use return labels.");
 	auto result = std::make_unique<CFG>();
 	result->entry = &result->makeBlock(debugDataOf(_block));
+	result->simulateFunctionsWithJumps = _simulateFunctionsWithJumps;
 
 	ControlFlowSideEffectsCollector sideEffects(_dialect, _block);
 	ControlFlowGraphBuilder builder(*result, _analysisInfo, sideEffects.functionSideEffects(), _dialect);
@@ -221,6 +273,8 @@ std::unique_ptr<CFG> ControlFlowGraphBuilder::build(
 
 	cleanUnreachable(*result);
 	markRecursiveCalls(*result);
+	if (_eliminateTailCalls)
+		markTailCalls(*result);
 	markStartsOfSubGraphs(*result);
 	markNeedsCleanStack(*result);
 
@@ -504,7 +558,8 @@ void ControlFlowGraphBuilder::registerFunction(FunctionDefinition const& _functi
 			};
 		}) | ranges::to<std::vector>,
 		{},
-		m_functionSideEffects.at(&_functionDefinition).canContinue
+		m_functionSideEffects.at(&_functionDefinition).canContinue,
+		m_functionSideEffects.at(&_functionDefinition).canTerminate
 	})).second;
 	yulAssert(inserted);
 }
@@ -540,7 +595,7 @@ Stack const& ControlFlowGraphBuilder::visitFunctionCall(FunctionCall const& _cal
 		Scope::Function const& function = lookupFunction(_call.functionName.name);
 		canContinue = m_graph.functionInfo.at(&function).canContinue;
 		Stack inputs;
-		if (canContinue)
+		if (canContinue && m_graph.simulateFunctionsWithJumps)
 			inputs.emplace_back(FunctionCallReturnLabelSlot{_call});
 		for (auto const& arg: _call.arguments | ranges::views::reverse)
 			inputs.emplace_back(std::visit(*this, arg));
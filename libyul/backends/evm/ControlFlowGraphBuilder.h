@@ -31,7 +31,17 @@ class ControlFlowGraphBuilder
 public:
 	ControlFlowGraphBuilder(ControlFlowGraphBuilder const&) = delete;
 	ControlFlowGraphBuilder& operator=(ControlFlowGraphBuilder const&) = delete;
-	static std::unique_ptr<CFG> build(AsmAnalysisInfo const& _analysisInfo, Dialect const& _dialect, Block const& _block);
+	/// Builds the control flow graph of @a _block. If @a _eliminateTailCalls is true, calls in tail position
+	/// of a function reuse the return label of that function (see ``CFG::FunctionCall::tailCall``).
+	/// If @a _simulateFunctionsWithJumps is false, function calls do not take a return label
+	/// (see ``CFG::simulateFunctionsWithJumps``), which rules out the elimination of tail calls.
+	static std::unique_ptr<CFG> build(
+		AsmAnalysisInfo const& _analysisInfo,
+		Dialect const& _dialect,
+		Block const& _block,
+		bool _eliminateTailCalls = false,
+		bool _simulateFunctionsWithJumps = true
+	);
 
 	StackSlot operator()(Expression const& _literal);
 	StackSlot operator()(Literal const& _literal);
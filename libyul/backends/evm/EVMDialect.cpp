@@ -132,7 +132,8 @@ std::set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 	for (auto const& instr: evmasm::c_instructions)
 	{
 		std::string name = toLower(instr.first);
-		if (!baseFeeException(instr.second) && !prevRandaoException(name))
+		// EOF instructions are not available as builtins, so their names remain usable as identifiers.
+		if (!baseFeeException(instr.second) && !prevRandaoException(name) && !evmasm::isEOFInstruction(instr.second))
 			reserved.emplace(name);
 	}
 	reserved += std::vector<YulString>{
@@ -39,10 +39,12 @@ void EVMObjectCompiler::compile(
 	AbstractAssembly& _assembly,
 	EVMDialect const& _dialect,
 	bool _optimize,
-	std::optional<uint8_t> _eofVersion
+	std::optional<uint8_t> _eofVersion,
+	bool _outlineColdBlocks,
+	bool _eliminateTailCalls
 )
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion);
+	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion, _outlineColdBlocks, _eliminateTailCalls);
 	compiler.run(_object, _optimize);
 }
 
@@ -59,7 +61,15 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name.str());
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion);
+			compile(
+				*subObject,
+				*subAssemblyAndID.first,
+				m_dialect,
+				_optimize,
+				m_eofVersion,
+				m_outlineColdBlocks,
+				m_eliminateTailCalls
+			);
 		}
 		else
 		{
@@ -86,7 +96,9 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			*_object.code,
 			m_dialect,
 			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName,
+			m_outlineColdBlocks,
+			m_eliminateTailCalls
 		);
 		if (!stackErrors.empty())
 		{
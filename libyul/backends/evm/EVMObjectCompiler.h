@@ -38,11 +38,23 @@ public:
 		AbstractAssembly& _assembly,
 		EVMDialect const& _dialect,
 		bool _optimize,
-		std::optional<uint8_t> _eofVersion
+		std::optional<uint8_t> _eofVersion,
+		bool _outlineColdBlocks = false,
+		bool _eliminateTailCalls = false
 	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, std::optional<uint8_t> _eofVersion):
-		m_assembly(_assembly), m_dialect(_dialect), m_eofVersion(_eofVersion)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		std::optional<uint8_t> _eofVersion,
+		bool _outlineColdBlocks,
+		bool _eliminateTailCalls
+	):
+		m_assembly(_assembly),
+		m_dialect(_dialect),
+		m_eofVersion(_eofVersion),
+		m_outlineColdBlocks(_outlineColdBlocks),
+		m_eliminateTailCalls(_eliminateTailCalls)
 	{}
 
 	void run(Object& _object, bool _optimize);
@@ -50,6 +62,10 @@ private:
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	std::optional<uint8_t> m_eofVersion;
+	/// Move blocks that always revert to the end of the code (only with the optimized code transform).
+	bool m_outlineColdBlocks = false;
+	/// Let calls in tail position return directly to the caller (only with the optimized code transform).
+	bool m_eliminateTailCalls = false;
 };
 
 }
@@ -75,6 +75,7 @@ void EthAssemblyAdapter::appendLabel(LabelID _labelId)
 
 void EthAssemblyAdapter::appendLabelReference(LabelID _labelId)
 {
+	yulAssert(!m_assembly.eofVersion(), "Label references are not available in EOF.");
 	m_assembly.append(evmasm::AssemblyItem(evmasm::PushTag, _labelId));
 }
 
@@ -100,22 +101,61 @@ void EthAssemblyAdapter::appendVerbatim(bytes _data, size_t _arguments, size_t _
 
 void EthAssemblyAdapter::appendJump(int _stackDiffAfter, JumpType _jumpType)
 {
+	yulAssert(!m_assembly.eofVersion(), "Dynamic jumps are not available in EOF.");
 	appendJumpInstruction(evmasm::Instruction::JUMP, _jumpType);
 	m_assembly.adjustDeposit(_stackDiffAfter);
 }
 
 void EthAssemblyAdapter::appendJumpTo(LabelID _labelId, int _stackDiffAfter, JumpType _jumpType)
 {
+	if (m_assembly.eofVersion())
+	{
+		yulAssert(_jumpType == JumpType::Ordinary, "Functions are called via CALLF in EOF.");
+		m_assembly.appendRelativeJump(evmasm::AssemblyItem(evmasm::Tag, _labelId));
+		m_assembly.adjustDeposit(_stackDiffAfter);
+		return;
+	}
 	appendLabelReference(_labelId);
 	appendJump(_stackDiffAfter, _jumpType);
 }
 
 void EthAssemblyAdapter::appendJumpToIf(LabelID _labelId, JumpType _jumpType)
 {
+	if (m_assembly.eofVersion())
+	{
+		yulAssert(_jumpType == JumpType::Ordinary, "Functions are called via CALLF in EOF.");
+		m_assembly.appendConditionalRelativeJump(evmasm::AssemblyItem(evmasm::Tag, _labelId));
+		return;
+	}
 	appendLabelReference(_labelId);
 	appendJumpInstruction(evmasm::Instruction::JUMPI, _jumpType);
 }
 
+AbstractAssembly::FunctionID EthAssemblyAdapter::registerFunction(uint8_t _arguments, uint8_t _returns)
+{
+	return m_assembly.createFunction(_arguments, _returns);
+}
+
+void EthAssemblyAdapter::beginFunction(FunctionID _functionID)
+{
+	m_assembly.beginFunction(_functionID);
+}
+
+void EthAssemblyAdapter::endFunction()
+{
+	m_assembly.endFunction();
+}
+
+void EthAssemblyAdapter::appendFunctionCall(FunctionID _functionID)
+{
+	m_assembly.appendFunctionCall(_functionID);
+}
+
+void EthAssemblyAdapter::appendFunctionReturn()
+{
+	m_assembly.appendFunctionReturn();
+}
+
 void EthAssemblyAdapter::appendAssemblySize()
 {
 	m_assembly.appendProgramSize();
@@ -123,7 +163,7 @@ void EthAssemblyAdapter::appendAssemblySize()
 
 std::pair<std::shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> EthAssemblyAdapter::createSubAssembly(bool _creation, std::string _name)
 {
-	std::shared_ptr<evmasm::Assembly> assembly{std::make_shared<evmasm::Assembly>(m_assembly.evmVersion(), _creation, std::move(_name))};
+	std::shared_ptr<evmasm::Assembly> assembly{std::make_shared<evmasm::Assembly>(m_assembly.evmVersion(), _creation, m_assembly.eofVersion(), std::move(_name))};
 	auto sub = m_assembly.newSub(assembly);
 	return {std::make_shared<EthAssemblyAdapter>(*assembly), static_cast<size_t>(sub.data())};
 }
@@ -185,6 +225,11 @@ langutil::EVMVersion EthAssemblyAdapter::evmVersion() const
 	return m_assembly.evmVersion();
 }
 
+std::optional<uint8_t> EthAssemblyAdapter::eofVersion() const
+{
+	return m_assembly.eofVersion();
+}
+
 EthAssemblyAdapter::LabelID EthAssemblyAdapter::assemblyTagToIdentifier(evmasm::AssemblyItem const& _tag)
 {
 	u256 id = _tag.data();
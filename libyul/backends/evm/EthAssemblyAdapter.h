@@ -54,6 +54,11 @@ public:
 	void appendJump(int _stackDiffAfter, JumpType _jumpType) override;
 	void appendJumpTo(LabelID _labelId, int _stackDiffAfter, JumpType _jumpType) override;
 	void appendJumpToIf(LabelID _labelId, JumpType _jumpType) override;
+	FunctionID registerFunction(uint8_t _arguments, uint8_t _returns) override;
+	void beginFunction(FunctionID _functionID) override;
+	void endFunction() override;
+	void appendFunctionCall(FunctionID _functionID) override;
+	void appendFunctionReturn() override;
 	void appendAssemblySize() override;
 	std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(bool _creation, std::string _name = {}) override;
 	void appendDataOffset(std::vector<SubID> const& _subPath) override;
@@ -68,6 +73,7 @@ public:
 	void markAsInvalid() override;
 
 	langutil::EVMVersion evmVersion() const override;
+	std::optional<uint8_t> eofVersion() const override;
 
 
 private:
@@ -92,6 +92,31 @@ void NoOutputAssembly::appendJumpToIf(LabelID _labelId, JumpType)
 	appendInstruction(evmasm::Instruction::JUMPI);
 }
 
+AbstractAssembly::FunctionID NoOutputAssembly::registerFunction(uint8_t, uint8_t)
+{
+	yulAssert(false, "Functions are only available in EOF.");
+}
+
+void NoOutputAssembly::beginFunction(FunctionID)
+{
+	yulAssert(false, "Functions are only available in EOF.");
+}
+
+void NoOutputAssembly::endFunction()
+{
+	yulAssert(false, "Functions are only available in EOF.");
+}
+
+void NoOutputAssembly::appendFunctionCall(FunctionID)
+{
+	yulAssert(false, "Functions are only available in EOF.");
+}
+
+void NoOutputAssembly::appendFunctionReturn()
+{
+	yulAssert(false, "Functions are only available in EOF.");
+}
+
 void NoOutputAssembly::appendAssemblySize()
 {
 	appendInstruction(evmasm::Instruction::PUSH1);
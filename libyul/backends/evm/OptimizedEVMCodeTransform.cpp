@@ -45,32 +45,66 @@ std::vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 	Block const& _block,
 	EVMDialect const& _dialect,
 	BuiltinContext& _builtinContext,
-	UseNamedLabels _useNamedLabelsForFunctions
+	UseNamedLabels _useNamedLabelsForFunctions,
+	bool _outlineColdBlocks,
+	bool _eliminateTailCalls
 )
 {
-	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
+	// In EOF, functions are called via CALLF, which pushes the return address to a separate return stack.
+	bool const eof = _assembly.eofVersion().has_value();
+	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(
+		_analysisInfo,
+		_dialect,
+		_block,
+		_eliminateTailCalls && !eof,
+		!eof /* _simulateFunctionsWithJumps */
+	);
 	StackLayout stackLayout = StackLayoutGenerator::run(*dfg);
 	OptimizedEVMCodeTransform optimizedCodeTransform(
 		_assembly,
 		_builtinContext,
 		_useNamedLabelsForFunctions,
 		*dfg,
-		stackLayout
+		stackLayout,
+		_outlineColdBlocks
 	);
 	// Create initial entry layout.
 	optimizedCodeTransform.createStackLayout(debugDataOf(*dfg->entry), stackLayout.blockInfos.at(dfg->entry).entryLayout);
 	optimizedCodeTransform(*dfg->entry);
-	for (Scope::Function const* function: dfg->functions)
-		optimizedCodeTransform(dfg->functionInfo.at(function));
+	// In EOF, every function has its own code section, so the cold blocks of the main code
+	// have to be generated before the functions.
+	if (_outlineColdBlocks && eof)
+		optimizedCodeTransform.generateColdBlocks();
+	if (_outlineColdBlocks)
+	{
+		// Functions that always revert are only called on cold paths, so they are placed after all
+		// other functions, followed by the cold blocks of all functions.
+		auto alwaysReverts = [&](Scope::Function const* _function) {
+			CFG::FunctionInfo const& info = dfg->functionInfo.at(_function);
+			return !info.canContinue && !info.canTerminate;
+		};
+		for (Scope::Function const* function: dfg->functions)
+			if (!alwaysReverts(function))
+				optimizedCodeTransform(dfg->functionInfo.at(function));
+		for (Scope::Function const* function: dfg->functions)
+			if (alwaysReverts(function))
+				optimizedCodeTransform(dfg->functionInfo.at(function));
+		optimizedCodeTransform.generateColdBlocks();
+	}
+	else
+		for (Scope::Function const* function: dfg->functions)
+			optimizedCodeTransform(dfg->functionInfo.at(function));
 	return std::move(optimizedCodeTransform.m_stackErrors);
 }
 
 void OptimizedEVMCodeTransform::operator()(CFG::FunctionCall const& _call)
 {
+	bool const hasReturnLabel = _call.canContinue && m_dfg.simulateFunctionsWithJumps;
+
 	// Validate stack.
 	{
 		yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
-		yulAssert(m_stack.size() >= _call.function.get().arguments.size() + (_call.canContinue ? 1 : 0), "");
+		yulAssert(m_stack.size() >= _call.function.get().arguments.size() + (hasReturnLabel ? 1 : 0), "");
 		// Assert that we got the correct arguments on stack for the call.
 		for (auto&& [arg, slot]: ranges::zip_view(
 			_call.functionCall.get().arguments | ranges::views::reverse,
@@ -78,7 +112,15 @@ void OptimizedEVMCodeTransform::operator()(CFG::FunctionCall const& _call)
 		))
 			validateSlot(slot, arg);
 		// Assert that we got the correct return label on stack.
-		if (_call.canContinue)
+		if (_call.tailCall)
+		{
+			yulAssert(m_currentFunctionInfo, "");
+			auto const* returnLabelSlot = std::get_if<FunctionReturnLabelSlot>(
+				&m_stack.at(m_stack.size() - _call.functionCall.get().arguments.size() - 1)
+			);
+			yulAssert(returnLabelSlot && &returnLabelSlot->function.get() == &m_currentFunctionInfo->function, "");
+		}
+		else if (hasReturnLabel)
 		{
 			auto const* returnLabelSlot = std::get_if<FunctionCallReturnLabelSlot>(
 				&m_stack.at(m_stack.size() - _call.functionCall.get().arguments.size() - 1)
@@ -88,21 +130,34 @@ void OptimizedEVMCodeTransform::operator()(CFG::FunctionCall const& _call)
 	}
 
 	// Emit code.
+	if (!m_dfg.simulateFunctionsWithJumps)
 	{
+		yulAssert(!_call.tailCall, "");
 		m_assembly.setSourceLocation(originLocationOf(_call));
+		m_assembly.appendFunctionCall(m_functionIDs.at(&m_dfg.functionInfo.at(&_call.function.get())));
+		// The code section has to end in a terminating instruction, even if the callee never returns.
+		if (!_call.canContinue)
+			m_assembly.appendInstruction(evmasm::Instruction::INVALID);
+	}
+	else
+	{
+		m_assembly.setSourceLocation(originLocationOf(_call));
+		// A tail call returns to the caller of the current function, so the jump does not enter a new function
+		// as far as the source mappings are concerned: the jump out of the callee balances the jump into the
+		// current function.
 		m_assembly.appendJumpTo(
 			getFunctionLabel(_call.function),
 			static_cast<int>(_call.function.get().returns.size() - _call.function.get().arguments.size()) - (_call.canContinue ? 1 : 0),
-			AbstractAssembly::JumpType::IntoFunction
+			_call.tailCall ? AbstractAssembly::JumpType::Ordinary : AbstractAssembly::JumpType::IntoFunction
 		);
-		if (_call.canContinue)
+		if (_call.canContinue && !_call.tailCall)
 			m_assembly.appendLabel(m_returnLabels.at(&_call.functionCall.get()));
 	}
 
 	// Update stack.
 	{
 		// Remove arguments and return label from m_stack.
-		for (size_t i = 0; i < _call.function.get().arguments.size() + (_call.canContinue ? 1 : 0); ++i)
+		for (size_t i = 0; i < _call.function.get().arguments.size() + (hasReturnLabel ? 1 : 0); ++i)
 			m_stack.pop_back();
 		// Push return values to m_stack.
 		for (size_t index: ranges::views::iota(0u, _call.function.get().returns.size()))
@@ -177,7 +232,8 @@ OptimizedEVMCodeTransform::OptimizedEVMCodeTransform(
 	BuiltinContext& _builtinContext,
 	UseNamedLabels _useNamedLabelsForFunctions,
 	CFG const& _dfg,
-	StackLayout const& _stackLayout
+	StackLayout const& _stackLayout,
+	bool _outlineColdBlocks
 ):
 	m_assembly(_assembly),
 	m_builtinContext(_builtinContext),
@@ -185,6 +241,8 @@ OptimizedEVMCodeTransform::OptimizedEVMCodeTransform(
 	m_stackLayout(_stackLayout),
 	m_functionLabels([&](){
 		std::map<CFG::FunctionInfo const*, AbstractAssembly::LabelID> functionLabels;
+		if (!m_dfg.simulateFunctionsWithJumps)
+			return functionLabels;
 		std::set<YulString> assignedFunctionNames;
 		for (Scope::Function const* function: m_dfg.functions)
 		{
@@ -203,7 +261,23 @@ OptimizedEVMCodeTransform::OptimizedEVMCodeTransform(
 				m_assembly.newLabelId();
 		}
 		return functionLabels;
-	}())
+	}()),
+	m_functionIDs([&](){
+		std::map<CFG::FunctionInfo const*, AbstractAssembly::FunctionID> functionIDs;
+		if (m_dfg.simulateFunctionsWithJumps)
+			return functionIDs;
+		for (Scope::Function const* function: m_dfg.functions)
+		{
+			// The EOF type section limits both numbers to 127.
+			yulAssert(function->arguments.size() <= 0x7f && function->returns.size() <= 0x7f, "Too many function arguments or return values.");
+			functionIDs[&m_dfg.functionInfo.at(function)] = m_assembly.registerFunction(
+				static_cast<uint8_t>(function->arguments.size()),
+				static_cast<uint8_t>(function->returns.size())
+			);
+		}
+		return functionIDs;
+	}()),
+	m_outlineColdBlocks(_outlineColdBlocks)
 {
 }
 
@@ -479,9 +553,15 @@ void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
 			}
 			// Note that each block visit terminates control flow, so we cannot fall through from the zero case.
 
-			// Generate the non-zero block, if not done already.
+			// Generate the non-zero block, if not done already. Cold blocks are deferred to the end of the code,
+			// unless they are reached by an unconditional jump in the meantime.
 			if (!m_generated.count(_conditionalJump.nonZero))
-				(*this)(*_conditionalJump.nonZero);
+			{
+				if (m_outlineColdBlocks && isCold(*_conditionalJump.nonZero))
+					m_coldBlocks.emplace_back(_conditionalJump.nonZero, m_currentFunctionInfo);
+				else
+					(*this)(*_conditionalJump.nonZero);
+			}
 		},
 		[&](CFG::BasicBlock::FunctionReturn const& _functionReturn)
 		{
@@ -493,11 +573,15 @@ void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
 			Stack exitStack = m_currentFunctionInfo->returnVariables | ranges::views::transform([](auto const& _varSlot){
 				return StackSlot{_varSlot};
 			}) | ranges::to<Stack>;
-			exitStack.emplace_back(FunctionReturnLabelSlot{_functionReturn.info->function});
+			if (m_dfg.simulateFunctionsWithJumps)
+				exitStack.emplace_back(FunctionReturnLabelSlot{_functionReturn.info->function});
 
 			// Create the function return layout and jump.
 			createStackLayout(debugDataOf(_functionReturn), exitStack);
-			m_assembly.appendJump(0, AbstractAssembly::JumpType::OutOfFunction);
+			if (m_dfg.simulateFunctionsWithJumps)
+				m_assembly.appendJump(0, AbstractAssembly::JumpType::OutOfFunction);
+			else
+				m_assembly.appendFunctionReturn();
 		},
 		[&](CFG::BasicBlock::Terminated const&)
 		{
@@ -505,7 +589,7 @@ void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
 			if (CFG::BuiltinCall const* builtinCall = std::get_if<CFG::BuiltinCall>(&_block.operations.back().operation))
 				yulAssert(builtinCall->builtin.get().controlFlowSideEffects.terminatesOrReverts(), "");
 			else if (CFG::FunctionCall const* functionCall = std::get_if<CFG::FunctionCall>(&_block.operations.back().operation))
-				yulAssert(!functionCall->canContinue);
+				yulAssert(!functionCall->canContinue || functionCall->tailCall);
 			else
 				yulAssert(false);
 		}
@@ -524,19 +608,70 @@ void OptimizedEVMCodeTransform::operator()(CFG::FunctionInfo const& _functionInf
 	yulAssert(m_stack.empty() && m_assembly.stackHeight() == 0, "");
 
 	// Create function entry layout in m_stack.
-	if (_functionInfo.canContinue)
+	if (_functionInfo.canContinue && m_dfg.simulateFunctionsWithJumps)
 		m_stack.emplace_back(FunctionReturnLabelSlot{_functionInfo.function});
 	for (auto const& param: _functionInfo.parameters | ranges::views::reverse)
 		m_stack.emplace_back(param);
-	m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
 
 	m_assembly.setSourceLocation(originLocationOf(_functionInfo));
-	m_assembly.appendLabel(getFunctionLabel(_functionInfo.function));
+	if (m_dfg.simulateFunctionsWithJumps)
+	{
+		m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+		m_assembly.appendLabel(getFunctionLabel(_functionInfo.function));
+	}
+	else
+		m_assembly.beginFunction(m_functionIDs.at(&_functionInfo));
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
 
 	// Create the entry layout of the function body block and visit.
 	createStackLayout(debugDataOf(_functionInfo), m_stackLayout.blockInfos.at(_functionInfo.entry).entryLayout);
 	(*this)(*_functionInfo.entry);
 
+	if (!m_dfg.simulateFunctionsWithJumps)
+	{
+		// The cold blocks of the function have to be part of its code section.
+		if (m_outlineColdBlocks)
+			generateColdBlocks();
+		m_assembly.endFunction();
+	}
+
 	m_stack.clear();
 	m_assembly.setStackHeight(0);
 }
+
+bool OptimizedEVMCodeTransform::isCold(CFG::BasicBlock const& _block) const
+{
+	if (!std::holds_alternative<CFG::BasicBlock::Terminated>(_block.exit))
+		return false;
+	yulAssert(!_block.operations.empty());
+	return std::visit(util::GenericVisitor{
+		[&](CFG::BuiltinCall const& _call) {
+			ControlFlowSideEffects const& sideEffects = _call.builtin.get().controlFlowSideEffects;
+			return !sideEffects.canContinue && !sideEffects.canTerminate;
+		},
+		[&](CFG::FunctionCall const& _call) {
+			CFG::FunctionInfo const& functionInfo = m_dfg.functionInfo.at(&_call.function.get());
+			return !functionInfo.canContinue && !functionInfo.canTerminate;
+		},
+		[](CFG::Assignment const&) { return false; }
+	}, _block.operations.back().operation);
+}
+
+void OptimizedEVMCodeTransform::generateColdBlocks()
+{
+	// In EOF, the cold blocks are generated at the end of the code section of the current function.
+	yulAssert(!m_currentFunctionInfo || !m_dfg.simulateFunctionsWithJumps, "");
+	// Generating a cold block never defers further blocks, since it does not end in a conditional jump.
+	for (auto const& [block, functionInfo]: m_coldBlocks)
+	{
+		if (m_generated.count(block))
+			continue;
+		yulAssert(m_dfg.simulateFunctionsWithJumps || functionInfo == m_currentFunctionInfo, "");
+		ScopedSaveAndRestore currentFunctionInfoRestore(m_currentFunctionInfo, functionInfo);
+		// The block is only reached by jumps, which establish its entry layout.
+		m_stack = m_stackLayout.blockInfos.at(block).entryLayout;
+		m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+		(*this)(*block);
+	}
+	m_coldBlocks.clear();
+}
@@ -53,7 +53,9 @@ public:
 		Block const& _block,
 		EVMDialect const& _dialect,
 		BuiltinContext& _builtinContext,
-		UseNamedLabels _useNamedLabelsForFunctions
+		UseNamedLabels _useNamedLabelsForFunctions,
+		bool _outlineColdBlocks = false,
+		bool _eliminateTailCalls = false
 	);
 
 	/// Generate code for the function call @a _call. Only public for using with std::visit.
@@ -68,7 +70,8 @@ private:
 		BuiltinContext& _builtinContext,
 		UseNamedLabels _useNamedLabelsForFunctions,
 		CFG const& _dfg,
-		StackLayout const& _stackLayout
+		StackLayout const& _stackLayout,
+		bool _outlineColdBlocks
 	);
 
 	/// Assert that it is valid to transition from @a _currentStack to @a _desiredStack.
@@ -97,6 +100,12 @@ private:
 	/// Resets m_stack.
 	void operator()(CFG::FunctionInfo const& _functionInfo);
 
+	/// @returns true if @a _block ends in a call that can neither continue nor terminate successfully,
+	/// i.e. if it is only executed on the way to a revert.
+	bool isCold(CFG::BasicBlock const& _block) const;
+	/// Generate code for all blocks deferred to the end of the code by @a m_coldBlocks.
+	void generateColdBlocks();
+
 	AbstractAssembly& m_assembly;
 	BuiltinContext& m_builtinContext;
 	CFG const& m_dfg;
@@ -105,11 +114,20 @@ private:
 	std::map<yul::FunctionCall const*, AbstractAssembly::LabelID> m_returnLabels;
 	std::map<CFG::BasicBlock const*, AbstractAssembly::LabelID> m_blockLabels;
 	std::map<CFG::FunctionInfo const*, AbstractAssembly::LabelID> const m_functionLabels;
+	/// IDs of the code sections of the functions. Only used in EOF, where functions are called via CALLF
+	/// instead of jumping to m_functionLabels.
+	std::map<CFG::FunctionInfo const*, AbstractAssembly::FunctionID> const m_functionIDs;
 	/// Set of blocks already generated. If any of the contained blocks is ever jumped to, m_blockLabels should
 	/// contain a jump label for it.
 	std::set<CFG::BasicBlock const*> m_generated;
 	CFG::FunctionInfo const* m_currentFunctionInfo = nullptr;
 	std::vector<StackTooDeepError> m_stackErrors;
+	/// If true, cold blocks that are jumped to conditionally are not generated in place but
+	/// collected in @a m_coldBlocks and generated after all functions (in EOF: at the end of the code section
+	/// they belong to).
+	bool const m_outlineColdBlocks = false;
+	/// Deferred cold blocks together with the function they belong to (nullptr for the main block).
+	std::vector<std::pair<CFG::BasicBlock const*, CFG::FunctionInfo const*>> m_coldBlocks;
 };
 
 }
@@ -66,7 +66,7 @@ public:
 	static std::vector<StackTooDeep> reportStackTooDeep(CFG const& _cfg, YulString _functionName);
 
 private:
-	StackLayoutGenerator(StackLayout& _context, CFG::FunctionInfo const* _functionInfo);
+	StackLayoutGenerator(StackLayout& _context, CFG::FunctionInfo const* _functionInfo, bool _simulateFunctionsWithJumps);
 
 	/// @returns the optimal entry stack layout, s.t. @a _operation can be applied to it and
 	/// the result can be transformed to @a _exitStack with minimal stack shuffling.
@@ -116,6 +116,8 @@ private:
 
 	StackLayout& m_layout;
 	CFG::FunctionInfo const* m_currentFunctionInfo = nullptr;
+	/// If true, function returns jump to a return label on stack (see ``CFG::simulateFunctionsWithJumps``).
+	bool m_simulateFunctionsWithJumps = true;
 };
 
 }
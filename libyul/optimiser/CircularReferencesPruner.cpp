@@ -26,10 +26,12 @@
 
 using namespace solidity::yul;
 
-void CircularReferencesPruner::run(OptimiserStepContext& _context, Block& _ast)
+bool CircularReferencesPruner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CircularReferencesPruner{_context.reservedIdentifiers}(_ast);
-	FunctionGrouper::run(_context, _ast);
+	CircularReferencesPruner pruner{_context.reservedIdentifiers};
+	pruner(_ast);
+	bool regrouped = FunctionGrouper::run(_context, _ast);
+	return pruner.m_changed || regrouped;
 }
 
 void CircularReferencesPruner::operator()(Block& _block)
@@ -42,10 +44,14 @@ void CircularReferencesPruner::operator()(Block& _block)
 		{
 			FunctionDefinition const& funDef = std::get<FunctionDefinition>(statement);
 			if (!functionsToKeep.count(funDef.name))
+			{
 				statement = Block{};
+				m_changed = true;
+			}
 		}
 
-	removeEmptyBlocks(_block);
+	if (removeEmptyBlocks(_block) > 0)
+		m_changed = true;
 }
 
 std::set<YulString> CircularReferencesPruner::functionsCalledFromOutermostContext(CallGraph const& _callGraph)
@@ -39,7 +39,8 @@ class CircularReferencesPruner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"CircularReferencesPruner"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	/// @returns true if the AST was modified.
+	static bool run(OptimiserStepContext& _context, Block& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
@@ -54,6 +55,7 @@ private:
 	std::set<YulString> functionsCalledFromOutermostContext(CallGraph const& _callGraph);
 
 	std::set<YulString> const& m_reservedIdentifiers;
+	bool m_changed = false;
 };
 
 }
@@ -0,0 +1,341 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/ConstantFunctionEvaluator.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <range/v3/algorithm/all_of.hpp>
+
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+using evmasm::Instruction;
+
+namespace
+{
+
+/// Thrown if a call cannot be evaluated at compile time.
+struct EvaluationAborted {};
+
+/// @returns the result of @a _instruction applied to @a _arguments (in source order),
+/// if it does not have side effects and does not depend on the state.
+std::optional<u256> evaluateInstruction(Instruction _instruction, std::vector<u256> const& _arguments)
+{
+	auto const& a = _arguments;
+	switch (_instruction)
+	{
+	case Instruction::ADD: return u256(a[0] + a[1]);
+	case Instruction::MUL: return u256(a[0] * a[1]);
+	case Instruction::SUB: return u256(a[0] - a[1]);
+	case Instruction::DIV: return a[1] == 0 ? u256(0) : u256(a[0] / a[1]);
+	case Instruction::SDIV: return a[1] == 0 ? u256(0) : s2u(u2s(a[0]) / u2s(a[1]));
+	case Instruction::MOD: return a[1] == 0 ? u256(0) : u256(a[0] % a[1]);
+	case Instruction::SMOD: return a[1] == 0 ? u256(0) : s2u(u2s(a[0]) % u2s(a[1]));
+	case Instruction::EXP: return exp256(a[0], a[1]);
+	case Instruction::NOT: return u256(~a[0]);
+	case Instruction::LT: return u256(a[0] < a[1] ? 1 : 0);
+	case Instruction::GT: return u256(a[0] > a[1] ? 1 : 0);
+	case Instruction::SLT: return u256(u2s(a[0]) < u2s(a[1]) ? 1 : 0);
+	case Instruction::SGT: return u256(u2s(a[0]) > u2s(a[1]) ? 1 : 0);
+	case Instruction::EQ: return u256(a[0] == a[1] ? 1 : 0);
+	case Instruction::ISZERO: return u256(a[0] == 0 ? 1 : 0);
+	case Instruction::AND: return u256(a[0] & a[1]);
+	case Instruction::OR: return u256(a[0] | a[1]);
+	case Instruction::XOR: return u256(a[0] ^ a[1]);
+	case Instruction::BYTE:
+		return a[0] >= 32 ? u256(0) : u256((a[1] >> unsigned(8 * (31 - a[0]))) & 0xff);
+	case Instruction::ADDMOD: return a[2] == 0 ? u256(0) : addmod256(a[0], a[1], a[2]);
+	case Instruction::MULMOD: return a[2] == 0 ? u256(0) : mulmod256(a[0], a[1], a[2]);
+	case Instruction::SIGNEXTEND:
+	{
+		if (a[0] >= 31)
+			return a[1];
+		unsigned testBit = unsigned(a[0]) * 8 + 7;
+		u256 mask = (u256(1) << testBit) - 1;
+		return boost::multiprecision::bit_test(a[1], testBit) ? u256(a[1] | ~mask) : u256(a[1] & mask);
+	}
+	case Instruction::SHL: return a[0] >= 256 ? u256(0) : u256(a[1] << unsigned(a[0]));
+	case Instruction::SHR: return a[0] >= 256 ? u256(0) : u256(a[1] >> unsigned(a[0]));
+	case Instruction::SAR:
+	{
+		bool const negative = boost::multiprecision::bit_test(a[1], 255);
+		if (a[0] >= 256)
+			return negative ? ~u256(0) : u256(0);
+		unsigned const shift = unsigned(a[0]);
+		if (shift == 0)
+			return a[1];
+		u256 result = a[1] >> shift;
+		if (negative)
+			result |= ~u256(0) << (256 - shift);
+		return result;
+	}
+	default:
+		return std::nullopt;
+	}
+}
+
+/**
+ * Interpreter for Yul code that only consists of pure computations.
+ * Throws EvaluationAborted on anything else.
+ */
+class PureEvaluator
+{
+public:
+	PureEvaluator(EVMDialect const& _dialect, std::map<YulString, FunctionDefinition const*> const& _functions):
+		m_dialect(_dialect),
+		m_functions(_functions)
+	{}
+
+	std::vector<u256> call(YulString _function, std::vector<u256> const& _arguments)
+	{
+		FunctionDefinition const* function = valueOrDefault(m_functions, _function, nullptr);
+		if (!function || m_callDepth >= ConstantFunctionEvaluator::MaxCallDepth)
+			throw EvaluationAborted{};
+		yulAssert(function->parameters.size() == _arguments.size(), "");
+
+		// The callee only sees its own parameters and return variables. The variables of the
+		// caller are moved out of the way and restored once the callee returns, which also
+		// keeps recursive calls of the same function apart.
+		std::map<YulString, u256> outerVariables = std::move(m_variables);
+		m_variables.clear();
+		for (size_t i = 0; i < _arguments.size(); ++i)
+			m_variables[function->parameters[i].name] = _arguments[i];
+		for (TypedName const& returnVariable: function->returnVariables)
+			m_variables[returnVariable.name] = 0;
+
+		++m_callDepth;
+		execute(function->body);
+		--m_callDepth;
+
+		std::vector<u256> result;
+		for (TypedName const& returnVariable: function->returnVariables)
+			result.emplace_back(m_variables.at(returnVariable.name));
+		m_variables = std::move(outerVariables);
+		return result;
+	}
+
+private:
+	enum class ControlFlow { Default, Break, Continue, Leave };
+
+	void step()
+	{
+		if (++m_steps > ConstantFunctionEvaluator::MaxSteps)
+			throw EvaluationAborted{};
+	}
+
+	ControlFlow execute(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			if (ControlFlow flow = execute(statement); flow != ControlFlow::Default)
+				return flow;
+		return ControlFlow::Default;
+	}
+
+	ControlFlow execute(Statement const& _statement)
+	{
+		step();
+		return std::visit(GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) {
+				evaluate(_expressionStatement.expression);
+				return ControlFlow::Default;
+			},
+			[&](Assignment const& _assignment) {
+				assign(_assignment.variableNames, *_assignment.value);
+				return ControlFlow::Default;
+			},
+			[&](VariableDeclaration const& _declaration) {
+				if (_declaration.value)
+					assign(_declaration.variables, *_declaration.value);
+				else
+					for (TypedName const& variable: _declaration.variables)
+						m_variables[variable.name] = 0;
+				return ControlFlow::Default;
+			},
+			[&](FunctionDefinition const&) {
+				return ControlFlow::Default;
+			},
+			[&](If const& _if) {
+				if (evaluateSingle(*_if.condition) != 0)
+					return execute(_if.body);
+				return ControlFlow::Default;
+			},
+			[&](Switch const& _switch) {
+				u256 value = evaluateSingle(*_switch.expression);
+				Case const* matchingCase = nullptr;
+				for (Case const& switchCase: _switch.cases)
+					if (!switchCase.value)
+						matchingCase = matchingCase ? matchingCase : &switchCase;
+					else if (valueOfLiteral(*switchCase.value) == value)
+					{
+						matchingCase = &switchCase;
+						break;
+					}
+				if (matchingCase)
+					return execute(matchingCase->body);
+				return ControlFlow::Default;
+			},
+			[&](ForLoop const& _loop) {
+				if (ControlFlow flow = execute(_loop.pre); flow == ControlFlow::Leave)
+					return flow;
+				while (evaluateSingle(*_loop.condition) != 0)
+				{
+					ControlFlow flow = execute(_loop.body);
+					if (flow == ControlFlow::Leave)
+						return flow;
+					if (flow == ControlFlow::Break)
+						break;
+					if (execute(_loop.post) == ControlFlow::Leave)
+						return ControlFlow::Leave;
+				}
+				return ControlFlow::Default;
+			},
+			[&](Break const&) { return ControlFlow::Break; },
+			[&](Continue const&) { return ControlFlow::Continue; },
+			[&](Leave const&) { return ControlFlow::Leave; },
+			[&](Block const& _block) { return execute(_block); }
+		}, _statement);
+	}
+
+	template <typename Variables>
+	void assign(Variables const& _variables, Expression const& _value)
+	{
+		std::vector<u256> values = evaluate(_value);
+		yulAssert(values.size() == _variables.size(), "");
+		for (size_t i = 0; i < values.size(); ++i)
+			m_variables[_variables[i].name] = values[i];
+	}
+
+	u256 evaluateSingle(Expression const& _expression)
+	{
+		std::vector<u256> values = evaluate(_expression);
+		yulAssert(values.size() == 1, "");
+		return values.front();
+	}
+
+	std::vector<u256> evaluate(Expression const& _expression)
+	{
+		step();
+		return std::visit(GenericVisitor{
+			[&](Literal const& _literal) -> std::vector<u256> {
+				return {valueOfLiteral(_literal)};
+			},
+			[&](Identifier const& _identifier) -> std::vector<u256> {
+				return {m_variables.at(_identifier.name)};
+			},
+			[&](FunctionCall const& _call) -> std::vector<u256> {
+				// Arguments are evaluated from right to left.
+				std::vector<u256> arguments(_call.arguments.size());
+				for (size_t i = _call.arguments.size(); i > 0; --i)
+					arguments[i - 1] = evaluateSingle(_call.arguments[i - 1]);
+
+				if (BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_call.functionName.name))
+				{
+					if (!builtin->instruction)
+						throw EvaluationAborted{};
+					if (std::optional<u256> result = evaluateInstruction(*builtin->instruction, arguments))
+						return {*result};
+					throw EvaluationAborted{};
+				}
+				return call(_call.functionName.name, arguments);
+			}
+		}, _expression);
+	}
+
+	EVMDialect const& m_dialect;
+	std::map<YulString, FunctionDefinition const*> const& m_functions;
+	std::map<YulString, u256> m_variables;
+	size_t m_steps = 0;
+	size_t m_callDepth = 0;
+};
+
+}
+
+void ConstantFunctionEvaluator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (!evmDialect)
+		return;
+
+	std::set<YulString> candidates;
+	for (auto const& [name, sideEffects]: ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed())
+		if (sideEffects.canContinue)
+			candidates.insert(name);
+
+	std::map<YulString, FunctionDefinition const*> functions = allFunctionDefinitions(_ast);
+	for (auto const& [name, function]: functions)
+		if (function->returnVariables.size() != 1)
+			candidates.erase(name);
+
+	ConstantFunctionEvaluator{*evmDialect, std::move(functions), std::move(candidates)}(_ast);
+}
+
+void ConstantFunctionEvaluator::visit(Expression& _expression)
+{
+	ASTModifier::visit(_expression);
+
+	auto* call = std::get_if<FunctionCall>(&_expression);
+	if (
+		!call ||
+		!m_candidates.count(call->functionName.name) ||
+		!ranges::all_of(call->arguments, [](Expression const& _argument) {
+			return std::holds_alternative<Literal>(_argument);
+		})
+	)
+		return;
+
+	std::vector<u256> arguments;
+	for (Expression const& argument: call->arguments)
+		arguments.emplace_back(valueOfLiteral(std::get<Literal>(argument)));
+
+	if (std::optional<std::vector<u256>> result = evaluate(call->functionName.name, arguments))
+	{
+		yulAssert(result->size() == 1, "");
+		YulString type = m_functions.at(call->functionName.name)->returnVariables.front().type;
+		_expression = Literal{call->debugData, LiteralKind::Number, YulString{formatNumber(result->front())}, type};
+	}
+}
+
+std::optional<std::vector<u256>> ConstantFunctionEvaluator::evaluate(YulString _function, std::vector<u256> const& _arguments)
+{
+	auto key = std::make_pair(_function, _arguments);
+	if (auto const* result = valueOrNullptr(m_results, key))
+		return *result;
+
+	std::optional<std::vector<u256>> result;
+	try
+	{
+		result = PureEvaluator{m_dialect, m_functions}.call(_function, _arguments);
+	}
+	catch (EvaluationAborted const&)
+	{
+	}
+	m_results[key] = result;
+	return result;
+}
@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that evaluates calls to functions with literal arguments at compile time.
+ */
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+struct EVMDialect;
+struct OptimiserStepContext;
+
+/**
+ * Replaces calls to functions with a single return value whose arguments are all literals
+ * by the value the function returns for these arguments, if that value can be computed at
+ * compile time.
+ *
+ * The value is computed by a small interpreter that only supports builtins without
+ * side effects that do not depend on the state, like ``add``, ``lt`` or ``shl``, and calls
+ * to other functions. Evaluation is aborted, and the call is kept as it is, if any other
+ * builtin (for example ``mstore`` or ``revert``) is reached, if the number of evaluation
+ * steps exceeds ``MaxSteps`` or if the call depth exceeds ``MaxCallDepth``.
+ * Since only the path taken for the given arguments is evaluated, functions like
+ * ``checked_add`` can be evaluated as long as the arguments do not lead to the revert.
+ *
+ * Example:
+ *
+ *  function f(a) -> r { r := add(a, 1) if gt(r, 10) { revert(0, 0) } }
+ *  let x := f(2)
+ *  let y := f(20)
+ *
+ * is transformed to
+ *
+ *  function f(a) -> r { r := add(a, 1) if gt(r, 10) { revert(0, 0) } }
+ *  let x := 3
+ *  let y := f(20)
+ *
+ * Requirements:
+ * - The Disambiguator must be run upfront.
+ * - Only works for EVM dialects.
+ */
+class ConstantFunctionEvaluator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"ConstantFunctionEvaluator"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::visit;
+	void visit(Expression& _expression) override;
+
+	/// Maximum number of statements and expressions evaluated for a single call.
+	static constexpr size_t MaxSteps = 10000;
+	/// Maximum nesting depth of calls during the evaluation of a single call.
+	static constexpr size_t MaxCallDepth = 64;
+
+private:
+	ConstantFunctionEvaluator(
+		EVMDialect const& _dialect,
+		std::map<YulString, FunctionDefinition const*> _functions,
+		std::set<YulString> _candidates
+	):
+		m_dialect(_dialect),
+		m_functions(std::move(_functions)),
+		m_candidates(std::move(_candidates))
+	{}
+
+	/// @returns the return values of the call to @a _function with arguments @a _arguments,
+	/// if they can be computed, using previously computed results if available.
+	std::optional<std::vector<u256>> evaluate(YulString _function, std::vector<u256> const& _arguments);
+
+	EVMDialect const& m_dialect;
+	std::map<YulString, FunctionDefinition const*> m_functions;
+	/// Functions that may return regularly and have a single return value.
+	std::set<YulString> m_candidates;
+	std::map<std::pair<YulString, std::vector<u256>>, std::optional<std::vector<u256>>> m_results;
+};
+
+}
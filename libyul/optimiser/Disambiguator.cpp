@@ -26,6 +26,8 @@
 #include <libyul/Exceptions.h>
 #include <libyul/Scope.h>
 
+#include <libsolutil/Visitor.h>
+
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
@@ -74,3 +76,85 @@ void Disambiguator::leaveScopeInternal(Scope& _scope)
 	assertThrow(m_scopes.back() == &_scope, OptimizerException, "");
 	m_scopes.pop_back();
 }
+
+void Disambiguator::renameInPlace(Block& _block)
+{
+	enterScope(_block);
+	for (Statement& statement: _block.statements)
+		renameInPlace(statement);
+	leaveScope(_block);
+}
+
+void Disambiguator::renameInPlace(Statement& _statement)
+{
+	std::visit(GenericVisitor{
+		[&](ExpressionStatement& _expressionStatement) { renameInPlace(_expressionStatement.expression); },
+		[&](VariableDeclaration& _varDecl) {
+			for (TypedName& variable: _varDecl.variables)
+				renameInPlace(variable);
+			if (_varDecl.value)
+				renameInPlace(*_varDecl.value);
+		},
+		[&](Assignment& _assignment) {
+			for (Identifier& variable: _assignment.variableNames)
+				renameInPlace(variable);
+			renameInPlace(*_assignment.value);
+		},
+		[&](If& _if) {
+			renameInPlace(*_if.condition);
+			renameInPlace(_if.body);
+		},
+		[&](Switch& _switch) {
+			renameInPlace(*_switch.expression);
+			for (Case& switchCase: _switch.cases)
+				renameInPlace(switchCase.body);
+		},
+		[&](FunctionDefinition& _function) {
+			// The function name belongs to the enclosing scope.
+			_function.name = translateIdentifier(_function.name);
+			enterFunction(_function);
+			for (TypedName& parameter: _function.parameters)
+				renameInPlace(parameter);
+			for (TypedName& returnVariable: _function.returnVariables)
+				renameInPlace(returnVariable);
+			renameInPlace(_function.body);
+			leaveFunction(_function);
+		},
+		[&](ForLoop& _forLoop) {
+			// Variables declared in the pre block are visible in all parts of the loop.
+			enterScope(_forLoop.pre);
+			renameInPlace(_forLoop.pre);
+			renameInPlace(*_forLoop.condition);
+			renameInPlace(_forLoop.post);
+			renameInPlace(_forLoop.body);
+			leaveScope(_forLoop.pre);
+		},
+		[&](Break&) {},
+		[&](Continue&) {},
+		[&](Leave&) {},
+		[&](Block& _block) { renameInPlace(_block); }
+	}, _statement);
+}
+
+void Disambiguator::renameInPlace(Expression& _expression)
+{
+	std::visit(GenericVisitor{
+		[&](FunctionCall& _call) {
+			renameInPlace(_call.functionName);
+			for (Expression& argument: _call.arguments)
+				renameInPlace(argument);
+		},
+		[&](Identifier& _identifier) { renameInPlace(_identifier); },
+		[&](Literal&) {}
+	}, _expression);
+}
+
+void Disambiguator::renameInPlace(TypedName& _variable)
+{
+	_variable.name = translateIdentifier(_variable.name);
+}
+
+void Disambiguator::renameInPlace(Identifier& _identifier)
+{
+	_identifier.name = translateIdentifier(_identifier.name);
+}
@@ -35,6 +35,9 @@ struct Dialect;
 
 /**
  * Creates a copy of a Yul AST replacing all identifiers by unique names.
+ *
+ * Alternatively, the identifiers can be replaced in place using @a disambiguateInPlace,
+ * which avoids copying the AST. Both ways produce the same names.
  */
 class Disambiguator: public ASTCopier
 {
@@ -51,6 +54,10 @@ public:
 	{
 	}
 
+	/// Replaces all identifiers in @a _block by unique names without copying it.
+	/// @a _block has to be the block the analysis info was created for.
+	void disambiguateInPlace(Block& _block) { renameInPlace(_block); }
+
 protected:
 	void enterScope(Block const& _block) override;
 	void leaveScope(Block const& _block) override;
@@ -61,6 +68,13 @@ protected:
 	void enterScopeInternal(Scope& _scope);
 	void leaveScopeInternal(Scope& _scope);
 
+	/// Renames the identifiers in the given node, visiting them in the same order as the copier.
+	void renameInPlace(Block& _block);
+	void renameInPlace(Statement& _statement);
+	void renameInPlace(Expression& _expression);
+	void renameInPlace(TypedName& _variable);
+	void renameInPlace(Identifier& _identifier);
+
 	AsmAnalysisInfo const& m_info;
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_externallyUsedIdentifiers;
@@ -37,10 +37,12 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void ExpressionJoiner::run(OptimiserStepContext& _context, Block& _ast)
+bool ExpressionJoiner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ExpressionJoiner{_ast}(_ast);
-	FunctionGrouper::run(_context, _ast);
+	ExpressionJoiner joiner{_ast};
+	joiner(_ast);
+	bool regrouped = FunctionGrouper::run(_context, _ast);
+	return joiner.m_changed || regrouped;
 }
 
 
@@ -59,7 +61,8 @@ void ExpressionJoiner::operator()(Block& _block)
 		m_latestStatementInBlock = i;
 	}
 
-	removeEmptyBlocks(_block);
+	if (removeEmptyBlocks(_block) > 0)
+		m_changed = true;
 	resetLatestStatementPointer();
 }
 
@@ -75,6 +78,7 @@ void ExpressionJoiner::visit(Expression& _e)
 
 			// Delete the variable declaration (also get the moved-from structure back into a sane state)
 			*latestStatement() = Block();
+			m_changed = true;
 
 			decrementLatestStatementPointer();
 		}
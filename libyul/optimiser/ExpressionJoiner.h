@@ -72,7 +72,8 @@ class ExpressionJoiner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ExpressionJoiner"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	/// @returns true if the AST was modified.
+	static bool run(OptimiserStepContext&, Block& _ast);
 
 private:
 	explicit ExpressionJoiner(Block& _ast);
@@ -94,6 +95,7 @@ private:
 	Block* m_currentBlock = nullptr;		///< Pointer to current block holding the statement being visited.
 	size_t m_latestStatementInBlock = 0;		///< Offset to m_currentBlock's statements of the last visited statement.
 	std::map<YulString, size_t> m_references;	///< Holds reference counts to all variable declarations in current block.
+	bool m_changed = false;		///< True if any expression was joined or any empty block removed.
 };
 
 }
@@ -44,11 +44,12 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
+bool FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
 	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
+	return inliner.m_inlinedCalls > 0;
 }
 
 FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
@@ -117,8 +118,10 @@ void FullInliner::run(Pass _pass)
 	});
 	for (FunctionDefinition* fun: functions)
 	{
-		handleBlock(fun->name, fun->body);
-		updateCodeSize(*fun);
+		// The body of a function only changes if something was inlined into it,
+		// otherwise the cached size is still accurate.
+		if (handleBlock(fun->name, fun->body) > 0)
+			updateCodeSize(*fun);
 	}
 
 	for (auto& statement: m_ast.statements)
@@ -247,9 +250,12 @@ void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
 	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
 }
 
-void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
+size_t FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
 {
-	InlineModifier{*this, m_nameDispenser, _currentFunctionName, m_dialect}(_block);
+	InlineModifier modifier{*this, m_nameDispenser, _currentFunctionName, m_dialect};
+	modifier(_block);
+	m_inlinedCalls += modifier.inlinedCalls();
+	return modifier.inlinedCalls();
 }
 
 bool FullInliner::recursive(FunctionDefinition const& _fun) const
@@ -298,6 +304,7 @@ std::vector<Statement> InlineModifier::performInline(Statement& _statement, Func
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
+	++m_inlinedCalls;
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
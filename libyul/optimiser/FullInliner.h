@@ -71,7 +71,8 @@ class FullInliner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"FullInliner"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	/// @returns true if at least one function call was inlined.
+	static bool run(OptimiserStepContext& _context, Block& _ast);
 
 	/// Inlining heuristic.
 	/// @param _callSite the name of the function in which the function call is located.
@@ -101,7 +102,9 @@ private:
 	std::map<YulString, size_t> callDepths() const;
 
 	void updateCodeSize(FunctionDefinition const& _fun);
-	void handleBlock(YulString _currentFunctionName, Block& _block);
+	/// Inlines calls inside the given block.
+	/// @returns the number of inlined calls.
+	size_t handleBlock(YulString _currentFunctionName, Block& _block);
 	bool recursive(FunctionDefinition const& _fun) const;
 
 	Pass m_pass;
@@ -119,7 +122,11 @@ private:
 	std::set<YulString> m_singleUse;
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
+	/// Code sizes of the function bodies. These are only recomputed for functions whose
+	/// body changed due to inlining.
 	std::map<YulString, size_t> m_functionSizes;
+	/// Total number of calls inlined over all passes.
+	size_t m_inlinedCalls = 0;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
@@ -140,10 +147,13 @@ public:
 
 	void operator()(Block& _block) override;
 
+	size_t inlinedCalls() const { return m_inlinedCalls; }
+
 private:
 	std::optional<std::vector<Statement>> tryInlineStatement(Statement& _statement);
 	std::vector<Statement> performInline(Statement& _statement, FunctionCall& _funCall);
 
+	size_t m_inlinedCalls = 0;
 	YulString m_currentFunction;
 	FullInliner& m_driver;
 	NameDispenser& m_nameDispenser;
@@ -0,0 +1,368 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/FunctionCache.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/Semantics.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmParser.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/ErrorReporter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Name of the cached function in canonical form.
+YulString const canonicalFunctionName{"f"};
+
+/// Name of the source that the source locations of code in canonical form refer to.
+/// The location `@src 0:i:i` stands for the i-th distinct debug data of the original function.
+std::shared_ptr<std::string const> const canonicalSourceName = std::make_shared<std::string const>("canonical");
+
+std::map<unsigned, std::shared_ptr<std::string const>> canonicalSourceNames()
+{
+	return {{0, canonicalSourceName}};
+}
+
+/// Determines whether a function only calls builtins that do not refer to the surrounding object.
+class SelfContainedChecker: public ASTWalker
+{
+public:
+	static bool run(Dialect const& _dialect, FunctionDefinition const& _function)
+	{
+		SelfContainedChecker checker{_dialect};
+		checker(_function.body);
+		return checker.m_selfContained;
+	}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _call) override
+	{
+		BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name);
+		if (!builtin || !builtin->literalArguments.empty())
+			m_selfContained = false;
+		ASTWalker::operator()(_call);
+	}
+
+private:
+	explicit SelfContainedChecker(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	Dialect const& m_dialect;
+	bool m_selfContained = true;
+};
+
+/// Copies the AST, renaming all identifiers apart from builtins. The first identifier is
+/// translated to @a _firstName, all others via the function provided.
+class Renamer: public ASTCopier
+{
+public:
+	Renamer(Dialect const& _dialect, YulString _firstName, std::function<YulString(YulString)> _newName):
+		m_dialect(_dialect),
+		m_firstName(_firstName),
+		m_newName(std::move(_newName))
+	{}
+
+protected:
+	YulString translateIdentifier(YulString _name) override
+	{
+		if (m_dialect.builtin(_name))
+			return _name;
+		if (!m_translations.count(_name))
+			m_translations[_name] = m_translations.empty() ? m_firstName : m_newName(_name);
+		return m_translations.at(_name);
+	}
+
+private:
+	Dialect const& m_dialect;
+	YulString m_firstName;
+	std::function<YulString(YulString)> m_newName;
+	std::map<YulString, YulString> m_translations;
+};
+
+/// Replaces the debug data of all nodes using the given function.
+class DebugDataReplacer: public ASTModifier
+{
+public:
+	using Replacement = std::function<std::shared_ptr<DebugData const>(std::shared_ptr<DebugData const> const&)>;
+
+	explicit DebugDataReplacer(Replacement _replacement): m_replacement(std::move(_replacement)) {}
+
+	using ASTModifier::operator();
+	void operator()(Literal& _literal) override { replace(_literal); }
+	void operator()(Identifier& _identifier) override { replace(_identifier); }
+	void operator()(FunctionCall& _call) override
+	{
+		replace(_call);
+		replace(_call.functionName);
+		ASTModifier::operator()(_call);
+	}
+	void operator()(ExpressionStatement& _statement) override { replace(_statement); ASTModifier::operator()(_statement); }
+	void operator()(Assignment& _assignment) override { replace(_assignment); ASTModifier::operator()(_assignment); }
+	void operator()(VariableDeclaration& _varDecl) override
+	{
+		replace(_varDecl);
+		for (TypedName& variable: _varDecl.variables)
+			replace(variable);
+		ASTModifier::operator()(_varDecl);
+	}
+	void operator()(If& _if) override { replace(_if); ASTModifier::operator()(_if); }
+	void operator()(Switch& _switch) override
+	{
+		replace(_switch);
+		for (Case& _case: _switch.cases)
+			replace(_case);
+		ASTModifier::operator()(_switch);
+	}
+	void operator()(FunctionDefinition& _function) override
+	{
+		replace(_function);
+		for (TypedName& parameter: _function.parameters)
+			replace(parameter);
+		for (TypedName& returnVariable: _function.returnVariables)
+			replace(returnVariable);
+		ASTModifier::operator()(_function);
+	}
+	void operator()(ForLoop& _for) override { replace(_for); ASTModifier::operator()(_for); }
+	void operator()(Break& _break) override { replace(_break); }
+	void operator()(Continue& _continue) override { replace(_continue); }
+	void operator()(Leave& _leave) override { replace(_leave); }
+	void operator()(Block& _block) override { replace(_block); ASTModifier::operator()(_block); }
+
+private:
+	template<typename Node>
+	void replace(Node& _node) { _node.debugData = m_replacement(_node.debugData); }
+
+	Replacement m_replacement;
+};
+
+/// Prints code in canonical form, including the canonical source locations.
+std::string printCanonical(Dialect const& _dialect, Block const& _code)
+{
+	return AsmPrinter(_dialect, canonicalSourceNames(), DebugInfoSelection::Only(&DebugInfoSelection::location))(_code);
+}
+
+/// Parses and analyzes code in canonical form.
+/// @returns an object without name and subobjects or nullptr on failure.
+std::unique_ptr<Object> parseCanonical(Dialect const& _dialect, std::string const& _code)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(_code, "");
+	auto object = std::make_unique<Object>();
+	object->code = Parser(errorReporter, _dialect, canonicalSourceNames()).parse(charStream);
+	if (!object->code || errorReporter.hasErrors())
+		return nullptr;
+	object->analysisInfo = std::make_shared<AsmAnalysisInfo>();
+	if (!AsmAnalyzer(*object->analysisInfo, errorReporter, _dialect).analyze(*object->code))
+		return nullptr;
+	return object;
+}
+
+/// @returns the function definitions of the optimized version of a function in canonical form
+/// or an empty vector if the code is not of the expected shape, i.e. does not define a function
+/// named `f` with the given number of parameters and return variables at top level and
+/// contains only functions and empty blocks otherwise.
+std::vector<Statement> extractFunctions(Block& _block, size_t _parameters, size_t _returnVariables)
+{
+	std::vector<Statement> functions;
+	bool found = false;
+	for (Statement& statement: _block.statements)
+		if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+		{
+			if (function->name == canonicalFunctionName)
+			{
+				if (function->parameters.size() != _parameters || function->returnVariables.size() != _returnVariables)
+					return {};
+				found = true;
+			}
+			functions.emplace_back(std::move(statement));
+		}
+		else if (auto const* block = std::get_if<Block>(&statement); !block || !block->statements.empty())
+			return {};
+	if (!found)
+		return {};
+	return functions;
+}
+
+}
+
+void FunctionCache::run(Dialect const& _dialect, Block& _ast, NameDispenser& _nameDispenser, Optimizer const& _optimize)
+{
+	// The absence of msize allows to remove memory accesses, which is only valid for the whole program.
+	if (!dynamic_cast<EVMDialect const*>(&_dialect) || MSizeFinder::containsMSize(_dialect, _ast))
+		return;
+
+	std::vector<Statement> appendedFunctions;
+	for (Statement& statement: _ast.statements)
+	{
+		auto* function = std::get_if<FunctionDefinition>(&statement);
+		if (!function || !SelfContainedChecker::run(_dialect, *function))
+			continue;
+
+		size_t variableCounter = 0;
+		Block canonicalFunction{{}, {}};
+		canonicalFunction.statements.emplace_back(Renamer(_dialect, canonicalFunctionName, [&](YulString) {
+			return YulString{"v" + std::to_string(variableCounter++)};
+		}).translate(statement));
+
+		// Debug data is replaced by its index in order of appearance, so that the optimized code
+		// retains the source locations of the original statements.
+		std::vector<std::shared_ptr<DebugData const>> debugData;
+		DebugDataReplacer([&](std::shared_ptr<DebugData const> const& _debugData) {
+			auto sameDebugData = [&](std::shared_ptr<DebugData const> const& _other) {
+				if (!_debugData || !_other)
+					return !_debugData && !_other;
+				return _debugData->originLocation == _other->originLocation && _debugData->astID == _other->astID;
+			};
+			size_t index = static_cast<size_t>(
+				std::find_if(debugData.begin(), debugData.end(), sameDebugData) - debugData.begin()
+			);
+			if (index == debugData.size())
+				debugData.emplace_back(_debugData);
+			int position = static_cast<int>(index);
+			return DebugData::create({}, SourceLocation{position, position, canonicalSourceName});
+		})(std::get<FunctionDefinition>(canonicalFunction.statements.front()));
+		std::string canonicalCode = printCanonical(_dialect, canonicalFunction) + "\n";
+		std::string key = keccak256(m_settingsKey + "\n" + canonicalCode).hex();
+
+		std::optional<std::string> optimizedCode = load(key);
+		if (optimizedCode)
+			++m_reusedFunctionCount;
+		else
+		{
+			std::unique_ptr<Object> object = parseCanonical(_dialect, canonicalCode);
+			if (!object)
+				continue;
+			_optimize(*object, {canonicalFunctionName});
+			optimizedCode = printCanonical(_dialect, *object->code) + "\n";
+			// Store the unoptimized function if the optimizer changed its shape in an unexpected way,
+			// so that subsequent runs do not have to retry.
+			if (extractFunctions(*object->code, function->parameters.size(), function->returnVariables.size()).empty())
+				optimizedCode = canonicalCode;
+			store(key, *optimizedCode);
+			++m_storedFunctionCount;
+		}
+
+		// The cached code is parsed even on a miss to make sure that the result does not depend on the cache contents.
+		std::unique_ptr<Object> object = parseCanonical(_dialect, *optimizedCode);
+		if (!object)
+			continue;
+		DebugDataReplacer([&](std::shared_ptr<DebugData const> const& _debugData) {
+			if (_debugData)
+			{
+				SourceLocation const& location = _debugData->originLocation;
+				if (
+					location.sourceName &&
+					*location.sourceName == *canonicalSourceName &&
+					0 <= location.start &&
+					static_cast<size_t>(location.start) < debugData.size()
+				)
+					return debugData[static_cast<size_t>(location.start)];
+			}
+			return function->debugData;
+		})(*object->code);
+		std::set<YulString> reservedIdentifiers = _dialect.fixedFunctionNames();
+		reservedIdentifiers.insert(canonicalFunctionName);
+		Disambiguator(_dialect, *object->analysisInfo, reservedIdentifiers).disambiguateInPlace(*object->code);
+
+		std::vector<Statement> functions = extractFunctions(
+			*object->code,
+			function->parameters.size(),
+			function->returnVariables.size()
+		);
+		if (functions.empty())
+			continue;
+
+		// Translate `f` first, so that it is the one receiving the original name.
+		Renamer renamer(_dialect, function->name, [&](YulString _name) { return _nameDispenser.newName(_name); });
+		renamer.translate(Expression{Identifier{{}, canonicalFunctionName}});
+		for (Statement& optimizedFunction: functions)
+			if (std::get<FunctionDefinition>(optimizedFunction).name == canonicalFunctionName)
+				statement = renamer.translate(optimizedFunction);
+			else
+				appendedFunctions.emplace_back(renamer.translate(optimizedFunction));
+	}
+	for (Statement& function: appendedFunctions)
+		_ast.statements.emplace_back(std::move(function));
+}
+
+std::optional<std::string> FunctionCache::load(std::string const& _key) const
+{
+	if (m_directory.empty())
+		return std::nullopt;
+	boost::filesystem::path path = m_directory / (_key + ".yul");
+	try
+	{
+		if (boost::filesystem::is_regular_file(path))
+			return readFileAsString(path);
+	}
+	catch (...)
+	{
+	}
+	return std::nullopt;
+}
+
+void FunctionCache::store(std::string const& _key, std::string const& _code) const
+{
+	if (m_directory.empty())
+		return;
+	boost::filesystem::path path = m_directory / (_key + ".yul");
+	try
+	{
+		boost::filesystem::create_directories(m_directory);
+		// Write to a temporary file first, so that concurrent compiler runs never read partial results.
+		boost::filesystem::path temporaryPath = path;
+		temporaryPath += "." + boost::filesystem::unique_path().string();
+		{
+			std::ofstream file(temporaryPath.string(), std::ios::binary);
+			file << _code;
+			if (!file)
+				return;
+		}
+		boost::filesystem::rename(temporaryPath, path);
+	}
+	catch (...)
+	{
+	}
+}
@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent cache of Yul functions optimized in isolation.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <functional>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+struct Object;
+class NameDispenser;
+
+/**
+ * Optimizes Yul functions in isolation and caches the results in a directory, so that they persist
+ * across compiler runs.
+ *
+ * Large parts of the generated code consist of helper functions that are identical across contracts and
+ * builds. Before the optimizer sequence is run on the whole object, each top-level function that only calls
+ * builtins (apart from builtins with literal arguments, which refer to the surrounding object) is replaced
+ * by the result of optimizing it on its own. The result is looked up in the cache by a hash of the canonical
+ * form of the function and the settings the cache was created with. If it is not present, the function is
+ * optimized and the result is stored. In the canonical form, all identifiers are renamed in order of
+ * appearance and the distinct source locations are numbered in order of appearance, so that the statements
+ * of the result get the source locations of the statements they originate from.
+ *
+ * Since a stored result is identical to the one of optimizing the function again, the output does not depend
+ * on the contents of the cache or on whether a directory is used at all. It differs from the output without
+ * isolated optimization, though, which is why that is a separate setting recorded in the metadata.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister, FunctionGrouper
+ */
+class FunctionCache
+{
+public:
+	/// Optimizes the given object containing a single function, whose name is in the given set.
+	using Optimizer = std::function<void(Object& _object, std::set<YulString> const& _externallyUsedIdentifiers)>;
+
+	/// @param _directory the directory the results are stored in. It is created if it does not exist.
+	/// If it is empty, the results are not stored.
+	/// @param _settingsKey a string that identifies the dialect and all settings that influence
+	/// the optimization of a function.
+	FunctionCache(boost::filesystem::path _directory, std::string _settingsKey):
+		m_directory(std::move(_directory)),
+		m_settingsKey(std::move(_settingsKey))
+	{}
+
+	/// Replaces all eligible top-level functions of @a _ast by their optimized versions, taken from the cache
+	/// or computed via @a _optimize. New identifiers are created using @a _nameDispenser.
+	void run(Dialect const& _dialect, Block& _ast, NameDispenser& _nameDispenser, Optimizer const& _optimize);
+
+	/// @returns the number of functions whose optimized versions were taken from the cache.
+	size_t reusedFunctionCount() const { return m_reusedFunctionCount; }
+	/// @returns the number of functions that were optimized and stored in the cache.
+	size_t storedFunctionCount() const { return m_storedFunctionCount; }
+
+private:
+	/// @returns the stored optimized version of a function in canonical form, if present.
+	std::optional<std::string> load(std::string const& _key) const;
+	/// Stores the optimized version @a _code of a function. Failures are ignored.
+	void store(std::string const& _key, std::string const& _code) const;
+
+	boost::filesystem::path m_directory;
+	std::string m_settingsKey;
+	size_t m_reusedFunctionCount = 0;
+	size_t m_storedFunctionCount = 0;
+};
+
+}
@@ -44,6 +44,7 @@ void FunctionGrouper::operator()(Block& _block)
 			std::get<Block>(reordered.front()).statements.emplace_back(std::move(statement));
 	}
 	_block.statements = std::move(reordered);
+	m_changed = true;
 }
 
 bool FunctionGrouper::alreadyGrouped(Block const& _block)
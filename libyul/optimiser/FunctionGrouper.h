@@ -36,12 +36,21 @@ struct OptimiserStepContext;
  * After this step, a block is of the form
  * { { I... } F... }
  * Where I are (non-function-definition) instructions and F are function definitions.
+ *
+ * The step reports whether it had to reorder anything, so that a block that is already
+ * grouped is not counted as a change by the optimiser suite.
  */
 class FunctionGrouper
 {
 public:
 	static constexpr char const* name{"FunctionGrouper"};
-	static void run(OptimiserStepContext&, Block& _ast) { FunctionGrouper{}(_ast); }
+	/// @returns true if the block was modified.
+	static bool run(OptimiserStepContext&, Block& _ast)
+	{
+		FunctionGrouper grouper;
+		grouper(_ast);
+		return grouper.m_changed;
+	}
 
 	void operator()(Block& _block);
 
@@ -49,6 +58,8 @@ private:
 	FunctionGrouper() = default;
 
 	bool alreadyGrouped(Block const& _block);
+
+	bool m_changed = false;
 };
 
 }
@@ -20,14 +20,17 @@
 
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/NameDispenser.h>
 
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
 #include <libyul/YulString.h>
 #include <libsolutil/CommonData.h>
 
 #include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/algorithm/equal.hpp>
 #include <range/v3/view/enumerate.hpp>
 
 #include <variant>
@@ -35,6 +38,26 @@
 using namespace solidity::util;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// @returns true if @a _lhs and @a _rhs have literals with the same values at the same positions.
+bool sameLiteralArguments(
+	FunctionSpecializer::LiteralArguments const& _lhs,
+	FunctionSpecializer::LiteralArguments const& _rhs
+)
+{
+	return ranges::equal(_lhs, _rhs, [](std::optional<Expression> const& _a, std::optional<Expression> const& _b) {
+		if (!_a || !_b)
+			return !_a && !_b;
+		Literal const& a = std::get<Literal>(*_a);
+		Literal const& b = std::get<Literal>(*_b);
+		return a.type == b.type && valueOfLiteral(a) == valueOfLiteral(b);
+	});
+}
+
+}
+
 FunctionSpecializer::LiteralArguments FunctionSpecializer::specializableArguments(
 	FunctionCall const& _f
 )
@@ -64,12 +87,33 @@ void FunctionSpecializer::operator()(FunctionCall& _f)
 
 	if (ranges::any_of(arguments, [](auto& _a) { return _a.has_value(); }))
 	{
-		YulString oldName = std::move(_f.functionName.name);
-		auto newName = m_nameDispenser.newName(oldName);
-
-		m_oldToNewMap[oldName].emplace_back(std::make_pair(newName, arguments));
+		YulString oldName = _f.functionName.name;
+		std::optional<YulString> newName;
+		if (m_shareSpecializations)
+		{
+			if (auto const* specializations = util::valueOrNullptr(m_oldToNewMap, oldName))
+				for (auto const& [specializedName, specializedArguments]: *specializations)
+					if (sameLiteralArguments(specializedArguments, arguments))
+					{
+						newName = specializedName;
+						break;
+					}
+			if (!newName)
+			{
+				size_t& specializedCodeSize = m_specializedCodeSizes[oldName];
+				size_t functionSize = util::valueOrDefault(m_functionSizes, oldName, size_t(0));
+				if (specializedCodeSize > 0 && specializedCodeSize + functionSize > MaxSpecializedCodeSize)
+					return;
+				specializedCodeSize += functionSize;
+			}
+		}
+		if (!newName)
+		{
+			newName = m_nameDispenser.newName(oldName);
+			m_oldToNewMap[oldName].emplace_back(std::make_pair(*newName, arguments));
+		}
 
-		_f.functionName.name = newName;
+		_f.functionName.name = *newName;
 		_f.arguments = util::filter(
 			_f.arguments,
 			applyMap(arguments, [](auto& _a) { return !_a; })
@@ -124,12 +168,21 @@ FunctionDefinition FunctionSpecializer::specialize(
 	return newFunction;
 }
 
-void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
+void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast, bool _shareSpecializations)
 {
+	std::map<YulString, size_t> functionSizes;
+	if (_shareSpecializations)
+		for (auto const& statement: _ast.statements)
+			if (auto const* functionDefinition = std::get_if<FunctionDefinition>(&statement))
+				// The copy additionally contains a variable declaration per specialized argument, which is ignored here.
+				functionSizes[functionDefinition->name] = CodeSize::codeSize(functionDefinition->body);
+
 	FunctionSpecializer f{
 		CallGraphGenerator::callGraph(_ast).recursiveFunctions(),
 		_context.dispenser,
-		_context.dialect
+		_context.dialect,
+		_shareSpecializations,
+		std::move(functionSizes)
 	};
 	f(_ast);
 
@@ -60,20 +60,32 @@ public:
 	using LiteralArguments = std::vector<std::optional<Expression>>;
 
 	static constexpr char const* name{"FunctionSpecializer"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void run(OptimiserStepContext& _context, Block& _ast) { run(_context, _ast, false); }
+	/// Runs the step. If @a _shareSpecializations is true, all calls of a function with the same literal
+	/// arguments share one specialized copy and the size of the copies of each function is limited
+	/// (see SharedFunctionSpecializer).
+	static void run(OptimiserStepContext& _context, Block& _ast, bool _shareSpecializations);
 
 	using ASTModifier::operator();
 	void operator()(FunctionCall& _f) override;
 
 private:
+	/// Total code size of the specialized copies of a function above which no further copies are created
+	/// when sharing specializations. A function is always specialized at least once.
+	static constexpr size_t MaxSpecializedCodeSize = 200;
+
 	explicit FunctionSpecializer(
 		std::set<YulString> _recursiveFunctions,
 		NameDispenser& _nameDispenser,
-		Dialect const& _dialect
+		Dialect const& _dialect,
+		bool _shareSpecializations,
+		std::map<YulString, size_t> _functionSizes
 	):
 		m_recursiveFunctions(std::move(_recursiveFunctions)),
 		m_nameDispenser(_nameDispenser),
-		m_dialect(_dialect)
+		m_dialect(_dialect),
+		m_shareSpecializations(_shareSpecializations),
+		m_functionSizes(std::move(_functionSizes))
 	{}
 	/// Returns a vector of Expressions, where the index `i` is an expression if the function's
 	/// `i`-th argument can be specialized, nullopt otherwise.
@@ -108,6 +120,35 @@ private:
 
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
+	/// If true, calls with the same literal arguments share one specialization.
+	bool const m_shareSpecializations = false;
+	/// Code size of each function, only used if specializations are shared.
+	std::map<YulString, size_t> const m_functionSizes;
+	/// Total code size of the specializations created for each function so far.
+	std::map<YulString, size_t> m_specializedCodeSizes;
+};
+
+/**
+ * SharedFunctionSpecializer: Optimiser step that works like the FunctionSpecializer, but creates
+ * only one specialized copy of a function for each combination of literal arguments, which is shared
+ * by all calls with these arguments, e.g. all calls `f(x, 5)` are replaced by calls `f_1(x)`.
+ *
+ * Further, once the specialized copies of a function reach a total code size of
+ * FunctionSpecializer::MaxSpecializedCodeSize, calls with new combinations of literal arguments
+ * are left unchanged.
+ *
+ * The step is not part of the default sequence, which uses the FunctionSpecializer.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister
+ */
+class SharedFunctionSpecializer
+{
+public:
+	static constexpr char const* name{"SharedFunctionSpecializer"};
+	static void run(OptimiserStepContext& _context, Block& _ast)
+	{
+		FunctionSpecializer::run(_context, _ast, true);
+	}
 };
 
 }
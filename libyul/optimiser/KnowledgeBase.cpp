@@ -54,6 +54,10 @@ std::optional<u256> KnowledgeBase::differenceIfKnownConstant(YulString _a, YulSt
 		return std::nullopt;
 }
 
+YulString KnowledgeBase::reference(YulString _a)
+{
+	return explore(_a).reference;
+}
 
 bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
 {
@@ -74,6 +74,9 @@ public:
 	bool knownToBeZero(YulString _a);
 	std::optional<u256> valueIfKnownConstant(YulString _a);
 	std::optional<u256> valueIfKnownConstant(Expression const& _expression);
+	/// @returns the variable relative to which the value of @a _a is known,
+	/// or the empty string if the value of @a _a is a known constant.
+	YulString reference(YulString _a);
 
 private:
 	/**
@@ -19,10 +19,14 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libevmasm/Instruction.h>
 #include <libsolutil/CommonData.h>
 
 #include <utility>
@@ -30,13 +34,83 @@
 using namespace solidity;
 using namespace solidity::yul;
 
+using evmasm::Instruction;
+
+namespace
+{
+
+/// Collects the locations written by ``sstore`` and ``mstore`` in a loop and
+/// marks the storage or memory as written at unknown locations for any other
+/// call that writes to them.
+class LoopStoreCollector: public ASTWalker
+{
+public:
+	LoopStoreCollector(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> const& _functionSideEffects
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+
+		std::optional<Instruction> instruction = toEVMInstruction(m_dialect, _functionCall.functionName.name);
+		if (instruction == Instruction::SSTORE)
+		{
+			if (m_stores.storage)
+				m_stores.storage->emplace_back(&_functionCall.arguments.front());
+			return;
+		}
+		if (instruction == Instruction::MSTORE)
+		{
+			if (m_stores.memory)
+				m_stores.memory->emplace_back(&_functionCall.arguments.front());
+			return;
+		}
+
+		SideEffects sideEffects;
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name))
+			sideEffects = builtin->sideEffects;
+		else if (auto it = m_functionSideEffects.find(_functionCall.functionName.name); it != m_functionSideEffects.end())
+			sideEffects = it->second;
+		else
+			sideEffects = SideEffects::worst();
+
+		if (sideEffects.storage == SideEffects::Write)
+			m_stores.storage.reset();
+		if (sideEffects.memory == SideEffects::Write)
+			m_stores.memory.reset();
+	}
+
+	LoopInvariantCodeMotion::LoopStores const& stores() const { return m_stores; }
+
+private:
+	Dialect const& m_dialect;
+	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	LoopInvariantCodeMotion::LoopStores m_stores;
+};
+
+}
+
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
 	std::map<YulString, SideEffects> functionSideEffects =
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	std::set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(_ast);
+	std::set<YulString> ssaVars;
+	std::map<YulString, AssignedValue> ssaValues;
+	for (auto const& [name, expression]: ssaValueTracker.values())
+	{
+		ssaVars.insert(name);
+		ssaValues[name] = AssignedValue{expression, {}};
+	}
+	LoopInvariantCodeMotion{_context.dialect, ssaVars, ssaValues, functionSideEffects, containsMSize}(_ast);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -57,13 +131,14 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	std::set<YulString> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
+	SideEffects const& _forLoopSideEffects,
+	LoopStores const& _loopStores
 ) const
 {
 	// A declaration can be promoted iff
 	// 1. Its LHS is a SSA variable
 	// 2. Its RHS only references SSA variables declared outside of the current scope
-	// 3. Its RHS is movable
+	// 3. Its RHS is movable, or it is a load from a location not written to in the loop
 
 	for (auto const& var: _varDecl.variables)
 		if (!m_ssaVariables.count(var.name))
@@ -74,18 +149,92 @@ bool LoopInvariantCodeMotion::canBePromoted(
 			if (_varsDefinedInCurrentScope.count(ref.first) || !m_ssaVariables.count(ref.first))
 				return false;
 		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
-		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
+		if (
+			!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize) &&
+			!isInvariantLoad(*_varDecl.value, _loopStores)
+		)
 			return false;
 	}
 	return true;
 }
 
+bool LoopInvariantCodeMotion::isInvariantLoad(Expression const& _value, LoopStores const& _loopStores) const
+{
+	FunctionCall const* call = std::get_if<FunctionCall>(&_value);
+	if (!call || call->arguments.size() != 1)
+		return false;
+	Expression const& location = call->arguments.front();
+	if (!std::holds_alternative<Identifier>(location) && !std::holds_alternative<Literal>(location))
+		return false;
+
+	std::optional<std::vector<Expression const*>> const* stores = nullptr;
+	u256 minDistance;
+	std::optional<Instruction> instruction = toEVMInstruction(m_dialect, call->functionName.name);
+	if (instruction == Instruction::SLOAD)
+	{
+		stores = &_loopStores.storage;
+		minDistance = 1;
+	}
+	else if (instruction == Instruction::MLOAD && !m_containsMSize)
+	{
+		stores = &_loopStores.memory;
+		minDistance = 32;
+	}
+	else
+		return false;
+
+	// Loads only depend on the storage or memory, respectively, so the writes
+	// to that area are the only effects of the loop that matter.
+	if (!*stores)
+		return false;
+	for (Expression const* store: **stores)
+		if (!knownToBeDisjoint(location, *store, minDistance))
+			return false;
+	return true;
+}
+
+bool LoopInvariantCodeMotion::knownToBeDisjoint(
+	Expression const& _a,
+	Expression const& _b,
+	u256 const& _minDistance
+) const
+{
+	std::optional<u256> difference;
+	if (std::holds_alternative<Identifier>(_a) && std::holds_alternative<Identifier>(_b))
+	{
+		// The knowledge base treats a variable without SSA value as a fixed unknown value,
+		// but it might be assigned inside the loop. Only SSA variables never change.
+		YulString reference = m_knowledgeBase.reference(std::get<Identifier>(_a).name);
+		if (!reference.empty() && !m_ssaVariables.count(reference))
+			return false;
+		difference = m_knowledgeBase.differenceIfKnownConstant(
+			std::get<Identifier>(_a).name,
+			std::get<Identifier>(_b).name
+		);
+	}
+	else
+	{
+		std::optional<u256> a = m_knowledgeBase.valueIfKnownConstant(_a);
+		std::optional<u256> b = m_knowledgeBase.valueIfKnownConstant(_b);
+		if (a && b)
+			difference = *a - *b;
+	}
+	return difference && *difference >= _minDistance && *difference <= u256(0) - _minDistance;
+}
+
 std::optional<std::vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 {
 	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	LoopStores loopStores;
+	if (forLoopSideEffects.storage == SideEffects::Write || forLoopSideEffects.memory == SideEffects::Write)
+	{
+		LoopStoreCollector collector{m_dialect, m_functionSideEffects};
+		collector(_for);
+		loopStores = collector.stores();
+	}
 
 	std::vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -98,7 +247,7 @@ std::optional<std::vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLo
 				if (std::holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, loopStores))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
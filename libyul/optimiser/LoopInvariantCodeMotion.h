@@ -18,9 +18,13 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/KnowledgeBase.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <optional>
+#include <vector>
+
 namespace solidity::yul
 {
 
@@ -32,6 +36,10 @@ namespace solidity::yul
  * Only statements at the top level in a loop's body or post block are considered, i.e variable
  * declarations inside conditional branches will not be moved out of the loop.
  *
+ * A ``sload`` or ``mload`` of a loop-invariant location is also moved if the loop writes to
+ * storage or memory, as long as all such writes are ``sstore`` or ``mstore`` calls to locations
+ * that are known to be different from (for memory: at least 32 bytes away from) the loaded one.
+ *
  * Requirements:
  * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
  * - Expression splitter and SSA transform should be run upfront to obtain better result.
@@ -45,31 +53,49 @@ public:
 
 	void operator()(Block& _block) override;
 
+	/// Locations written to by ``sstore`` and ``mstore`` inside a loop.
+	/// A value of nullopt means that the loop writes to unknown locations of that kind.
+	struct LoopStores
+	{
+		std::optional<std::vector<Expression const*>> storage = std::vector<Expression const*>{};
+		std::optional<std::vector<Expression const*>> memory = std::vector<Expression const*>{};
+	};
+
 private:
 	explicit LoopInvariantCodeMotion(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
+		std::map<YulString, AssignedValue> const& _ssaValues,
 		std::map<YulString, SideEffects> const& _functionSideEffects,
 		bool _containsMSize
 	):
 		m_containsMSize(_containsMSize),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
-		m_functionSideEffects(_functionSideEffects)
+		m_functionSideEffects(_functionSideEffects),
+		m_knowledgeBase(_ssaValues)
 	{ }
 
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulString> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
+		SideEffects const& _forLoopSideEffects,
+		LoopStores const& _loopStores
 	) const;
+	/// @returns true if @a _value is a storage or memory load that does not alias
+	/// any of the stores in @a _loopStores.
+	bool isInvariantLoad(Expression const& _value, LoopStores const& _loopStores) const;
+	/// @returns true if the locations @a _a and @a _b are known to be at least
+	/// @a _minDistance apart.
+	bool knownToBeDisjoint(Expression const& _a, Expression const& _b, u256 const& _minDistance) const;
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
 	bool m_containsMSize = true;
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
 	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	KnowledgeBase mutable m_knowledgeBase;
 };
 
 }
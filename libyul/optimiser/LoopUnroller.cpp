@@ -0,0 +1,198 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+#include <libevmasm/Instruction.h>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+using evmasm::Instruction;
+
+namespace
+{
+
+/// Finds ``break`` and ``continue`` statements that belong to the loop being visited,
+/// i.e. not those inside nested loops.
+class BreakContinueFinder: public ASTWalker
+{
+public:
+	static bool containsBreakOrContinue(Block const& _body)
+	{
+		BreakContinueFinder finder;
+		finder(_body);
+		return finder.m_found;
+	}
+
+	using ASTWalker::operator();
+	void operator()(ForLoop const& _loop) override
+	{
+		// Only the body of a nested loop can contain statements referring to it.
+		visit(*_loop.condition);
+		(*this)(_loop.post);
+	}
+	void operator()(Break const&) override { m_found = true; }
+	void operator()(Continue const&) override { m_found = true; }
+
+private:
+	bool m_found = false;
+};
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	// Unrolling only pays off for code that is executed many times.
+	if (!_context.expectedExecutionsPerDeployment)
+		return;
+
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(_ast);
+	std::map<YulString, AssignedValue> ssaValues;
+	for (auto const& [name, expression]: ssaValueTracker.values())
+		ssaValues[name] = AssignedValue{expression, {}};
+
+	LoopUnroller{
+		_context.dialect,
+		_context.dispenser,
+		ssaValues,
+		*_context.expectedExecutionsPerDeployment
+	}(_ast);
+}
+
+void LoopUnroller::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	for (size_t i = 1; i < _block.statements.size(); ++i)
+		if (ForLoop const* loop = std::get_if<ForLoop>(&_block.statements[i]))
+			if (std::optional<Block> unrolled = tryUnroll(_block.statements[i - 1], *loop))
+				_block.statements[i] = std::move(*unrolled);
+}
+
+std::optional<Block> LoopUnroller::tryUnroll(Statement const& _previous, ForLoop const& _loop)
+{
+	yulAssert(_loop.pre.statements.empty(), "ForLoopInitRewriter has to be run before LoopUnroller.");
+
+	auto increment = loopIncrement(_loop.post);
+	if (!increment)
+		return std::nullopt;
+	auto const& [variable, step] = *increment;
+
+	// The iteration variable has to be initialized with a constant right in front of the loop.
+	VariableDeclaration const* declaration = std::get_if<VariableDeclaration>(&_previous);
+	if (!declaration || declaration->variables.size() != 1 || declaration->variables.front().name != variable)
+		return std::nullopt;
+	std::optional<u256> initialValue =
+		declaration->value ? m_knowledgeBase.valueIfKnownConstant(*declaration->value) : u256(0);
+	if (!initialValue)
+		return std::nullopt;
+
+	// The condition has to be ``lt(i, n)`` with constant ``n``.
+	FunctionCall const* condition = std::get_if<FunctionCall>(_loop.condition.get());
+	if (
+		!condition ||
+		toEVMInstruction(m_dialect, condition->functionName.name) != Instruction::LT ||
+		!std::holds_alternative<Identifier>(condition->arguments.at(0)) ||
+		std::get<Identifier>(condition->arguments.at(0)).name != variable
+	)
+		return std::nullopt;
+	std::optional<u256> bound = m_knowledgeBase.valueIfKnownConstant(condition->arguments.at(1));
+	if (!bound)
+		return std::nullopt;
+
+	if (
+		assignedVariableNames(_loop.body).count(variable) ||
+		BreakContinueFinder::containsBreakOrContinue(_loop.body)
+	)
+		return std::nullopt;
+
+	// Determine the values of the iteration variable after each iteration.
+	std::vector<u256> values;
+	for (u256 value = *initialValue; value < *bound; )
+	{
+		if (values.size() == MaxIterations)
+			return std::nullopt;
+		value += step;
+		values.emplace_back(value);
+	}
+
+	size_t const bodySize = CodeSize::codeSize(_loop.body);
+	if (values.size() * bodySize > MaxUnrolledSize)
+		return std::nullopt;
+	// Each iteration saves the loop overhead, each copy of the body apart from
+	// the first one has to be deployed.
+	bigint const gasSaved = bigint(values.size()) * LoopOverheadGas * m_expectedExecutionsPerDeployment;
+	bigint const deployCost =
+		bigint(values.size() > 0 ? values.size() - 1 : 0) * bodySize * DeployGasPerCodeSize;
+	if (gasSaved <= deployCost)
+		return std::nullopt;
+
+	std::shared_ptr<DebugData const> const& debugData = _loop.debugData;
+	YulString const type = declaration->variables.front().type;
+	Block unrolled{debugData, {}};
+	for (u256 const& value: values)
+	{
+		unrolled.statements.emplace_back(
+			std::get<Block>(BodyCopier{m_nameDispenser, {}}(_loop.body))
+		);
+		unrolled.statements.emplace_back(Assignment{
+			debugData,
+			{Identifier{debugData, variable}},
+			std::make_unique<Expression>(Literal{debugData, LiteralKind::Number, YulString{formatNumber(value)}, type})
+		});
+	}
+	return unrolled;
+}
+
+std::optional<std::pair<YulString, u256>> LoopUnroller::loopIncrement(Block const& _post)
+{
+	if (_post.statements.size() != 1)
+		return std::nullopt;
+	Assignment const* assignment = std::get_if<Assignment>(&_post.statements.front());
+	if (!assignment || assignment->variableNames.size() != 1)
+		return std::nullopt;
+	YulString variable = assignment->variableNames.front().name;
+
+	FunctionCall const* add = std::get_if<FunctionCall>(assignment->value.get());
+	if (!add || toEVMInstruction(m_dialect, add->functionName.name) != Instruction::ADD)
+		return std::nullopt;
+
+	for (auto&& [self, other]: {std::pair{0, 1}, std::pair{1, 0}})
+	{
+		Identifier const* identifier = std::get_if<Identifier>(&add->arguments.at(static_cast<size_t>(self)));
+		if (identifier && identifier->name == variable)
+			if (std::optional<u256> step = m_knowledgeBase.valueIfKnownConstant(
+				add->arguments.at(static_cast<size_t>(other))
+			))
+				return std::pair{variable, *step};
+	}
+	return std::nullopt;
+}
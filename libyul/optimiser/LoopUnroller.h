@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that fully unrolls for loops with a small constant trip count.
+ */
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+
+namespace solidity::yul
+{
+
+struct AssignedValue;
+struct Dialect;
+struct OptimiserStepContext;
+class NameDispenser;
+
+/**
+ * Fully unrolls for loops whose number of iterations is a small constant.
+ *
+ * A loop of the form
+ *
+ *  let i := c0
+ *  for { } lt(i, n) { i := add(i, s) } { body }
+ *
+ * where ``c0``, ``n`` and ``s`` are known constants, ``i`` is not assigned inside the body
+ * and the body does not contain ``break`` or ``continue`` is replaced by
+ *
+ *  {
+ *      { body }
+ *      i := c1
+ *      { body }
+ *      i := c2
+ *      ...
+ *  }
+ *
+ * where ``c1``, ``c2``, ... are the values of ``i`` after each iteration. Variables declared
+ * in the copies of the body are renamed.
+ *
+ * A loop is only unrolled if it has at most ``MaxIterations`` iterations, the unrolled code is
+ * not larger than ``MaxUnrolledSize`` and the gas saved by removing the loop overhead, multiplied
+ * by the expected number of executions, outweighs the cost of deploying the additional code.
+ * Loops in creation code are never unrolled.
+ *
+ * Requirements:
+ * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
+ * - Only works for EVM dialects.
+ */
+class LoopUnroller: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+	/// Maximum number of iterations of a loop that is unrolled.
+	static constexpr size_t MaxIterations = 16;
+	/// Maximum code size (as measured by CodeSize) of all copies of the body together.
+	static constexpr size_t MaxUnrolledSize = 256;
+	/// Estimated gas cost of one iteration of the loop apart from the body:
+	/// evaluating the condition, the increment and the jumps.
+	static constexpr size_t LoopOverheadGas = 40;
+	/// Estimated deployment gas cost of one unit of CodeSize (about two bytes).
+	static constexpr size_t DeployGasPerCodeSize = 400;
+
+private:
+	LoopUnroller(
+		Dialect const& _dialect,
+		NameDispenser& _nameDispenser,
+		std::map<YulString, AssignedValue> const& _ssaValues,
+		size_t _expectedExecutionsPerDeployment
+	):
+		m_dialect(_dialect),
+		m_nameDispenser(_nameDispenser),
+		m_knowledgeBase(_ssaValues),
+		m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment)
+	{}
+
+	/// @returns the replacement for @a _loop if it can be unrolled, given that
+	/// @a _previous is the statement directly in front of it.
+	std::optional<Block> tryUnroll(Statement const& _previous, ForLoop const& _loop);
+	/// @returns the iteration variable and the step if @a _post is of the form
+	/// ``i := add(i, s)`` or ``i := add(s, i)`` with constant ``s``.
+	std::optional<std::pair<YulString, u256>> loopIncrement(Block const& _post);
+
+	Dialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	KnowledgeBase m_knowledgeBase;
+	size_t m_expectedExecutionsPerDeployment = 0;
+};
+
+}
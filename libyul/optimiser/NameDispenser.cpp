@@ -25,10 +25,15 @@
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
 #include <libyul/YulString.h>
 
 #include <libsolutil/CommonData.h>
 
+#include <array>
+#include <charconv>
+#include <limits>
+
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
@@ -47,14 +52,35 @@ NameDispenser::NameDispenser(Dialect const& _dialect, std::set<YulString> _usedN
 
 YulString NameDispenser::newName(YulString _nameHint)
 {
-	YulString name = _nameHint;
-	while (illegalName(name))
+	if (!illegalName(_nameHint))
+	{
+		m_usedNames.emplace(_nameHint);
+		return _nameHint;
+	}
+
+	// Candidates are assembled in a single buffer and only added to the string
+	// repository once they are known not to be in use. A candidate that is not
+	// in the repository yet cannot be a used name.
+	std::string candidate = _nameHint.str() + "_";
+	size_t const prefixLength = candidate.size();
+	std::array<char, std::numeric_limits<size_t>::digits10 + 1> digits{};
+	while (true)
 	{
 		m_counter++;
-		name = YulString(_nameHint.str() + "_" + std::to_string(m_counter));
+		auto [end, error] = std::to_chars(digits.data(), digits.data() + digits.size(), m_counter);
+		yulAssert(error == std::errc{});
+		candidate.resize(prefixLength);
+		candidate.append(digits.data(), end);
+
+		std::optional<YulString> existing = YulString::find(candidate);
+		if (existing && m_usedNames.count(*existing))
+			continue;
+		YulString name = existing ? *existing : YulString(candidate);
+		if (isRestrictedIdentifier(m_dialect, name))
+			continue;
+		m_usedNames.emplace(name);
+		return name;
 	}
-	m_usedNames.emplace(name);
-	return name;
 }
 
 bool NameDispenser::illegalName(YulString _name)
@@ -23,6 +23,7 @@
 #include <optional>
 #include <string>
 #include <set>
+#include <type_traits>
 
 namespace solidity::yul
 {
@@ -51,7 +52,10 @@ struct OptimiserStep
 	explicit OptimiserStep(std::string _name): name(std::move(_name)) {}
 	virtual ~OptimiserStep() = default;
 
-	virtual void run(OptimiserStepContext&, Block&) const = 0;
+	/// Runs the step on the given AST.
+	/// @returns false only if the step is known to have left the AST unchanged. Steps whose
+	/// static ``run`` function does not report modifications are always assumed to change the AST.
+	virtual bool run(OptimiserStepContext&, Block&) const = 0;
 	/// @returns non-nullopt if the step cannot be run, for example because it requires
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
@@ -76,9 +80,15 @@ private:
 
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
-	void run(OptimiserStepContext& _context, Block& _ast) const override
+	bool run(OptimiserStepContext& _context, Block& _ast) const override
 	{
-		Step::run(_context, _ast);
+		if constexpr (std::is_same_v<decltype(Step::run(_context, _ast)), bool>)
+			return Step::run(_context, _ast);
+		else
+		{
+			Step::run(_context, _ast);
+			return true;
+		}
 	}
 	std::optional<std::string> invalidInCurrentEnvironment() const override
 	{
@@ -36,12 +36,14 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::yul;
 
-void yul::removeEmptyBlocks(Block& _block)
+size_t yul::removeEmptyBlocks(Block& _block)
 {
 	auto isEmptyBlock = [](Statement const& _st) -> bool {
 		return std::holds_alternative<Block>(_st) && std::get<Block>(_st).statements.empty();
 	};
+	size_t const originalSize = _block.statements.size();
 	ranges::actions::remove_if(_block.statements, isEmptyBlock);
+	return originalSize - _block.statements.size();
 }
 
 bool yul::isRestrictedIdentifier(Dialect const& _dialect, YulString const& _identifier)
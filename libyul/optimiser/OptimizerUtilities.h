@@ -41,7 +41,8 @@ namespace solidity::yul
 /// Removes statements that are just empty blocks (non-recursive).
 /// If this is run on the outermost block, the FunctionGrouper should be run afterwards to keep
 /// the canonical form.
-void removeEmptyBlocks(Block& _block);
+/// @returns the number of removed statements.
+size_t removeEmptyBlocks(Block& _block);
 
 /// Returns true if a given literal can not be used as an identifier.
 /// This includes Yul keywords and builtins of the given dialect.
@@ -29,7 +29,9 @@
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
+#include <libyul/optimiser/ConstantFunctionEvaluator.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/FunctionCache.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/EqualStoreEliminator.h>
@@ -60,6 +62,7 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
@@ -139,7 +142,8 @@ void OptimiserSuite::run(
 	std::string_view _optimisationSequence,
 	std::string_view _optimisationCleanupSequence,
 	std::optional<size_t> _expectedExecutionsPerDeployment,
-	std::set<YulString> const& _externallyUsedIdentifiers
+	std::set<YulString> const& _externallyUsedIdentifiers,
+	FunctionCache* _functionCache
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -151,11 +155,11 @@ void OptimiserSuite::run(
 	std::set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
-	*_object.code = std::get<Block>(Disambiguator(
+	Disambiguator(
 		_dialect,
 		*_object.analysisInfo,
 		reservedIdentifiers
-	)(*_object.code));
+	).disambiguateInPlace(*_object.code);
 	Block& ast = *_object.code;
 
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
@@ -167,6 +171,20 @@ void OptimiserSuite::run(
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
 	suite.runSequence("hgfo", ast);
 
+	if (_functionCache)
+		_functionCache->run(_dialect, ast, dispenser, [&](Object& _function, std::set<YulString> const& _externallyUsed) {
+			run(
+				_dialect,
+				_meter,
+				_function,
+				_optimizeStackAllocation,
+				_optimisationSequence,
+				_optimisationCleanupSequence,
+				_expectedExecutionsPerDeployment,
+				_externallyUsed
+			);
+		});
+
 	NameSimplifier::run(suite.m_context, ast);
 	// Now the user-supplied part
 	suite.runSequence(_optimisationSequence, ast);
@@ -251,6 +269,7 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::all
 			CommonSubexpressionEliminator,
 			ConditionalSimplifier,
 			ConditionalUnsimplifier,
+			ConstantFunctionEvaluator,
 			ControlFlowSimplifier,
 			DeadCodeEliminator,
 			EqualStoreEliminator,
@@ -269,11 +288,13 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::all
 			LiteralRematerialiser,
 			LoadResolver,
 			LoopInvariantCodeMotion,
+			LoopUnroller,
 			UnusedAssignEliminator,
 			UnusedStoreEliminator,
 			Rematerialiser,
 			SSAReverser,
 			SSATransform,
+			SharedFunctionSpecializer,
 			StructuralSimplifier,
 			UnusedFunctionParameterPruner,
 			UnusedPruner,
@@ -292,6 +313,7 @@ std::map<std::string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{CommonSubexpressionEliminator::name, 'c'},
 		{ConditionalSimplifier::name,         'C'},
 		{ConditionalUnsimplifier::name,       'U'},
+		{ConstantFunctionEvaluator::name,     'Q'},
 		{ControlFlowSimplifier::name,         'n'},
 		{DeadCodeEliminator::name,            'D'},
 		{EqualStoreEliminator::name,          'E'},
@@ -310,11 +332,13 @@ std::map<std::string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopUnroller::name,                  'R'},
 		{UnusedAssignEliminator::name,        'r'},
 		{UnusedStoreEliminator::name,         'S'},
 		{Rematerialiser::name,                'm'},
 		{SSAReverser::name,                   'V'},
 		{SSATransform::name,                  'a'},
+		{SharedFunctionSpecializer::name,     'K'},
 		{StructuralSimplifier::name,          't'},
 		{UnusedFunctionParameterPruner::name, 'p'},
 		{UnusedPruner::name,                  'u'},
@@ -402,7 +426,7 @@ bool OptimiserSuite::isEmptyOptimizerSequence(std::string const& _sequence)
 	return true;
 }
 
-void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
+bool OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
 {
 	validateSequence(_stepAbbreviations);
 
@@ -472,29 +496,39 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 			subsequences.push_back({subsequence, true});
 	}
 
+	bool changed = false;
 	size_t codeSize = 0;
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
+		bool changedInRound = false;
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
 			if (repeat)
-				runSequence(subsequence, _ast, true);
+				changedInRound |= runSequence(subsequence, _ast, true);
 			else
-				runSequence(abbreviationsToSteps(subsequence), _ast);
+				changedInRound |= runSequence(abbreviationsToSteps(subsequence), _ast);
 		}
+		changed |= changedInRound;
 
 		if (!_repeatUntilStable)
 			break;
 
+		// If no step modified the AST, the code size is still the one computed
+		// at the end of the previous round, so there is no need to recompute it.
+		if (round > 0 && !changedInRound)
+			break;
+
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
 		if (newSize == codeSize)
 			break;
 		codeSize = newSize;
 	}
+	return changed;
 }
 
-void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
+bool OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
 {
+	bool changed = false;
 	std::unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = std::make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
@@ -505,7 +539,7 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 #ifdef PROFILE_OPTIMIZER_STEPS
 		steady_clock::time_point startTime = steady_clock::now();
 #endif
-		allSteps().at(step)->run(m_context, _ast);
+		changed |= allSteps().at(step)->run(m_context, _ast);
 #ifdef PROFILE_OPTIMIZER_STEPS
 		steady_clock::time_point endTime = steady_clock::now();
 		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
@@ -523,4 +557,5 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 			}
 		}
 	}
+	return changed;
 }
@@ -37,6 +37,7 @@ namespace solidity::yul
 
 struct AsmAnalysisInfo;
 struct Dialect;
+class FunctionCache;
 class GasMeter;
 struct Object;
 
@@ -62,6 +63,8 @@ public:
 	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _functionCache is given, it is used to substitute top-level functions by their
+	/// optimized versions before the optimisation sequence is run.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -70,7 +73,8 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		FunctionCache* _functionCache = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -81,8 +85,13 @@ public:
 	static bool isEmptyOptimizerSequence(std::string const& _sequence);
 
 
-	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
-	void runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable = false);
+	/// Runs the given steps in order.
+	/// @returns false only if none of the steps modified the AST.
+	bool runSequence(std::vector<std::string> const& _steps, Block& _ast);
+	/// Runs the given sequence. Bracketed parts are repeated until the code size
+	/// stabilizes or no step reports a modification.
+	/// @returns false only if none of the steps modified the AST.
+	bool runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable = false);
 
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
 	static std::map<std::string, char> const& stepNameToAbbreviationMap();
@@ -37,7 +37,7 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
+bool UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
 	UnusedAssignEliminator uae{
 		_context.dialect,
@@ -50,6 +50,7 @@ void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	std::set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
 	StatementRemover remover{toRemove};
 	remover(_ast);
+	return !toRemove.empty();
 }
 
 void UnusedAssignEliminator::operator()(Identifier const& _identifier)
@@ -117,7 +117,8 @@ class UnusedAssignEliminator: public UnusedStoreBase
 {
 public:
 	static constexpr char const* name{"UnusedAssignEliminator"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	/// @returns true if an assignment was removed.
+	static bool run(OptimiserStepContext&, Block& _ast);
 
 	explicit UnusedAssignEliminator(
 		Dialect const& _dialect,
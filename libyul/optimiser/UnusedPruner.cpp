@@ -33,10 +33,12 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
+bool UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers);
-	FunctionGrouper::run(_context, _ast);
+	size_t modifications =
+		UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers);
+	bool regrouped = FunctionGrouper::run(_context, _ast);
+	return modifications > 0 || regrouped;
 }
 
 UnusedPruner::UnusedPruner(
@@ -79,6 +81,7 @@ void UnusedPruner::operator()(Block& _block)
 			{
 				subtractReferences(ReferencesCounter::countReferences(funDef.body));
 				statement = Block{std::move(funDef.debugData), {}};
+				++m_modifications;
 			}
 		}
 		else if (std::holds_alternative<VariableDeclaration>(statement))
@@ -96,7 +99,10 @@ void UnusedPruner::operator()(Block& _block)
 			))
 			{
 				if (!varDecl.value)
+				{
 					statement = Block{std::move(varDecl.debugData), {}};
+					++m_modifications;
+				}
 				else if (
 					SideEffectsCollector(m_dialect, *varDecl.value, m_functionSideEffects).
 					canBeRemoved(m_allowMSizeOptimization)
@@ -104,13 +110,17 @@ void UnusedPruner::operator()(Block& _block)
 				{
 					subtractReferences(ReferencesCounter::countReferences(*varDecl.value));
 					statement = Block{std::move(varDecl.debugData), {}};
+					++m_modifications;
 				}
 				else if (varDecl.variables.size() == 1 && m_dialect.discardFunction(varDecl.variables.front().type))
+				{
 					statement = ExpressionStatement{varDecl.debugData, FunctionCall{
 						varDecl.debugData,
 						{varDecl.debugData, m_dialect.discardFunction(varDecl.variables.front().type)->name},
 						{*std::move(varDecl.value)}
 					}};
+					++m_modifications;
+				}
 			}
 		}
 		else if (std::holds_alternative<ExpressionStatement>(statement))
@@ -123,15 +133,16 @@ void UnusedPruner::operator()(Block& _block)
 			{
 				subtractReferences(ReferencesCounter::countReferences(exprStmt.expression));
 				statement = Block{std::move(exprStmt.debugData), {}};
+				++m_modifications;
 			}
 		}
 
-	removeEmptyBlocks(_block);
+	m_modifications += removeEmptyBlocks(_block);
 
 	ASTModifier::operator()(_block);
 }
 
-void UnusedPruner::runUntilStabilised(
+size_t UnusedPruner::runUntilStabilised(
 	Dialect const& _dialect,
 	Block& _ast,
 	bool _allowMSizeOptimization,
@@ -139,18 +150,20 @@ void UnusedPruner::runUntilStabilised(
 	std::set<YulString> const& _externallyUsedFunctions
 )
 {
+	size_t modifications = 0;
 	while (true)
 	{
 		UnusedPruner pruner(
 			_dialect, _ast, _allowMSizeOptimization, _functionSideEffects,
 							_externallyUsedFunctions);
 		pruner(_ast);
+		modifications += pruner.m_modifications;
 		if (!pruner.shouldRunAgain())
-			return;
+			return modifications;
 	}
 }
 
-void UnusedPruner::runUntilStabilisedOnFullAST(
+size_t UnusedPruner::runUntilStabilisedOnFullAST(
 	Dialect const& _dialect,
 	Block& _ast,
 	std::set<YulString> const& _externallyUsedFunctions
@@ -159,7 +172,13 @@ void UnusedPruner::runUntilStabilisedOnFullAST(
 	std::map<YulString, SideEffects> functionSideEffects =
 		SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast));
 	bool allowMSizeOptimization = !MSizeFinder::containsMSize(_dialect, _ast);
-	runUntilStabilised(_dialect, _ast, allowMSizeOptimization, &functionSideEffects, _externallyUsedFunctions);
+	return runUntilStabilised(
+		_dialect,
+		_ast,
+		allowMSizeOptimization,
+		&functionSideEffects,
+		_externallyUsedFunctions
+	);
 }
 
 void UnusedPruner::runUntilStabilised(
@@ -50,7 +50,8 @@ class UnusedPruner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"UnusedPruner"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	/// @returns true if the AST was modified.
+	static bool run(OptimiserStepContext& _context, Block& _ast);
 
 
 	using ASTModifier::operator();
@@ -60,7 +61,8 @@ public:
 	bool shouldRunAgain() const { return m_shouldRunAgain; }
 
 	// Run the pruner until the code does not change anymore.
-	static void runUntilStabilised(
+	// @returns the number of modified statements.
+	static size_t runUntilStabilised(
 		Dialect const& _dialect,
 		Block& _ast,
 		bool _allowMSizeOptimization,
@@ -81,7 +83,8 @@ public:
 	/// The provided block has to be a full AST.
 	/// The pruner itself determines if msize is used and which user-defined functions
 	/// are side-effect free.
-	static void runUntilStabilisedOnFullAST(
+	/// @returns the number of modified statements.
+	static size_t runUntilStabilisedOnFullAST(
 		Dialect const& _dialect,
 		Block& _ast,
 		std::set<YulString> const& _externallyUsedFunctions = {}
@@ -121,6 +124,8 @@ private:
 	bool m_allowMSizeOptimization = false;
 	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
 	bool m_shouldRunAgain = false;
+	/// Number of statements removed or replaced, including removed empty blocks.
+	size_t m_modifications = 0;
 	std::map<YulString, size_t> m_references;
 };
 
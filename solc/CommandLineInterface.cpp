@@ -800,7 +800,12 @@ void CommandLineInterface::assembleFromEVMAssemblyJSON()
 	solAssert(m_fileReader.sourceUnits().size() == 1);
 	auto&& [sourceUnitName, source] = *m_fileReader.sourceUnits().begin();
 
-	auto evmAssemblyStack = std::make_unique<evmasm::EVMAssemblyStack>(m_options.output.evmVersion);
+	auto evmAssemblyStack = std::make_unique<evmasm::EVMAssemblyStack>(
+		m_options.output.evmVersion,
+		// Imported assemblies are only optimised on request. Unlike compilation, this does not imply
+		// the minimal optimisations, so that importing an assembly alone does not modify it.
+		m_options.optimizer.optimizeEvmasm ? m_options.optimiserSettings() : OptimiserSettings::none()
+	);
 	try
 	{
 		evmAssemblyStack->parseAndAnalyze(sourceUnitName, source);
@@ -873,6 +878,27 @@ void CommandLineInterface::compile()
 			))
 		);
 
+		CompilerStack::RetainedArtifacts retainedArtifacts;
+		retainedArtifacts.ir = m_options.compiler.outputs.ir;
+		retainedArtifacts.irAst = m_options.compiler.outputs.irAstJson;
+		retainedArtifacts.irOptimized = m_options.compiler.outputs.irOptimized;
+		retainedArtifacts.irOptimizedAst = m_options.compiler.outputs.irOptimizedAstJson;
+		retainedArtifacts.evmAssembly =
+			m_options.compiler.estimateGas ||
+			m_options.compiler.outputs.asm_ ||
+			m_options.compiler.outputs.asmJson ||
+			(m_options.compiler.combinedJsonRequests && (
+				m_options.compiler.combinedJsonRequests->asm_ ||
+				m_options.compiler.combinedJsonRequests->srcMap ||
+				m_options.compiler.combinedJsonRequests->srcMapRuntime
+			));
+		retainedArtifacts.generatedSources =
+			m_options.compiler.combinedJsonRequests && (
+				m_options.compiler.combinedJsonRequests->generatedSources ||
+				m_options.compiler.combinedJsonRequests->generatedSourcesRuntime
+			);
+		m_compiler->setRetainedArtifacts(retainedArtifacts);
+
 		m_compiler->setOptimiserSettings(m_options.optimiserSettings());
 
 		if (m_options.input.mode == InputMode::CompilerWithASTImport)
@@ -87,6 +87,7 @@ static std::string const g_strOptimize = "optimize";
 static std::string const g_strOptimizeRuns = "optimize-runs";
 static std::string const g_strOptimizeYul = "optimize-yul";
 static std::string const g_strYulOptimizations = "yul-optimizations";
+static std::string const g_strYulFunctionCache = "yul-function-cache";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
 static std::string const g_strRevertStrings = "revert-strings";
@@ -256,6 +257,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.optimizeYul == _other.optimizer.optimizeYul &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.yulFunctionCache == _other.optimizer.yulFunctionCache &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -290,6 +292,12 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 			solAssert(settings.yulOptimiserCleanupSteps == OptimiserSettings::DefaultYulOptimiserCleanupSteps);
 	}
 
+	if (optimizer.yulFunctionCache.has_value())
+	{
+		settings.isolatedFunctionOptimization = true;
+		settings.yulFunctionCacheDirectory = optimizer.yulFunctionCache.value().string();
+	}
+
 	return settings;
 }
 
@@ -824,6 +832,15 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("steps"),
 			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulFunctionCache.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Optimize self-contained Yul functions in isolation and store the results in the given directory "
+			"to reuse them in later runs. The output does not depend on the contents of the directory. "
+			"Isolated optimization may change the output and is recorded in the metadata. "
+			"Stored results are only identified by the compiler version string, so the directory has to be "
+			"cleared when switching between differently built or modified compilers of the same version."
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -1049,6 +1066,8 @@ void CommandLineParser::processArgs()
 			g_strCombinedJson,
 			g_strInputFile,
 			g_strJsonIndent,
+			g_strOptimize,
+			g_strOptimizeRuns,
 			g_strPrettyJson,
 			"srcmap",
 			"srcmap-runtime",
@@ -1079,7 +1098,7 @@ void CommandLineParser::processArgs()
 				"Option --" + g_strOptimizeRuns + " is only valid in compiler and assembler modes."
 			);
 
-		for (std::string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations})
+		for (std::string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations, g_strYulFunctionCache})
 			if (m_args.count(option) > 0)
 				solThrow(
 					CommandLineValidationError,
@@ -1247,6 +1266,13 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<std::string>();
 	}
 
+	if (m_args.count(g_strYulFunctionCache))
+	{
+		if (!m_options.optimizer.optimizeYul)
+			solThrow(CommandLineValidationError, "--" + g_strYulFunctionCache + " is invalid if Yul optimizer is disabled.");
+		m_options.optimizer.yulFunctionCache = m_args[g_strYulFunctionCache].as<std::string>();
+	}
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		std::vector<std::string> const nonAssemblyModeOptions = {
@@ -228,6 +228,7 @@ struct CommandLineOptions
 		bool optimizeYul = false;
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		std::optional<std::string> yulSteps;
+		std::optional<boost::filesystem::path> yulFunctionCache;
 	} optimizer;
 
 	struct
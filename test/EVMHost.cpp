@@ -86,7 +86,7 @@ bool EVMHost::checkVmPaths(vector<boost::filesystem::path> const& _vmPaths)
 	return evmVmFound;
 }
 
-EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
+EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm, std::optional<uint8_t> _eofVersion):
 	m_vm(_vm),
 	m_evmVersion(_evmVersion)
 {
@@ -121,6 +121,13 @@ EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
 	else
 		assertThrow(false, Exception, "Unsupported EVM version");
 
+	if (_eofVersion.has_value())
+	{
+		assertThrow(*_eofVersion == 1, Exception, "Unsupported EOF version");
+		assertThrow(_evmVersion == langutil::EVMVersion{}, Exception, "EOF is only supported for the most recent EVM version");
+		m_evmRevision = EVMC_PRAGUE;
+	}
+
 	if (m_evmRevision >= EVMC_PARIS)
 		// This is the value from the merge block.
 		tx_context.block_prev_randao = 0xa86c2e601b6c44eb4848f7d23d9df3113fbcac42041c49cbed5000cb4f118777_bytes32;
@@ -32,6 +32,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <optional>
+
 namespace solidity::test
 {
 using Address = util::h160;
@@ -75,7 +77,8 @@ public:
 	/// @returns true, if an evmc vm supporting evm1 was loaded properly,
 	static bool checkVmPaths(std::vector<boost::filesystem::path> const& _vmPaths);
 
-	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm);
+	/// @param _eofVersion if set, the VM executes the most recent revision, which supports EOF containers.
+	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm, std::optional<uint8_t> _eofVersion = std::nullopt);
 
 	/// Reset entire state (including accounts).
 	void reset();
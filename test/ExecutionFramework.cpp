@@ -48,12 +48,21 @@ using namespace solidity::test;
 using namespace solidity::frontend::test;
 
 ExecutionFramework::ExecutionFramework():
-	ExecutionFramework(solidity::test::CommonOptions::get().evmVersion(), solidity::test::CommonOptions::get().vmPaths)
+	ExecutionFramework(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().vmPaths,
+		solidity::test::CommonOptions::get().eofVersion()
+	)
 {
 }
 
-ExecutionFramework::ExecutionFramework(langutil::EVMVersion _evmVersion, vector<boost::filesystem::path> const& _vmPaths):
+ExecutionFramework::ExecutionFramework(
+	langutil::EVMVersion _evmVersion,
+	vector<boost::filesystem::path> const& _vmPaths,
+	std::optional<uint8_t> _eofVersion
+):
 	m_evmVersion(_evmVersion),
+	m_eofVersion(_eofVersion),
 	m_optimiserSettings(solidity::frontend::OptimiserSettings::minimal()),
 	m_showMessages(solidity::test::CommonOptions::get().showMessages),
 	m_vmPaths(_vmPaths)
@@ -71,7 +80,7 @@ void ExecutionFramework::selectVM(evmc_capabilities _cap)
 		evmc::VM& vm = EVMHost::getVM(path.string());
 		if (vm.has_capability(_cap))
 		{
-			m_evmcHost = make_unique<EVMHost>(m_evmVersion, vm);
+			m_evmcHost = make_unique<EVMHost>(m_evmVersion, vm, m_eofVersion);
 			break;
 		}
 	}
@@ -23,6 +23,7 @@
 #include <test/Common.h>
 
 #include <libevmasm/Assembly.h>
+#include <libsolutil/CommonData.h>
 #include <libsolutil/JSON.h>
 #include <libevmasm/Disassemble.h>
 #include <libyul/Exceptions.h>
@@ -61,15 +62,15 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 		{ "verbatim.asm", 2 }
 	};
 	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
-	Assembly _assembly{evmVersion, false, {}};
+	Assembly _assembly{evmVersion, false, std::nullopt, {}};
 	auto root_asm = std::make_shared<std::string>("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
-	Assembly _subAsm{evmVersion, false, {}};
+	Assembly _subAsm{evmVersion, false, std::nullopt, {}};
 	auto sub_asm = std::make_shared<std::string>("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 
-	Assembly _verbatimAsm(evmVersion, true, "");
+	Assembly _verbatimAsm(evmVersion, true, std::nullopt, "");
 	auto verbatim_asm = std::make_shared<std::string>("verbatim.asm");
 	_verbatimAsm.setSourceLocation({8, 18, verbatim_asm});
 
@@ -246,7 +247,7 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 				{ *subName, 1 }
 			};
 
-			auto subAsm = std::make_shared<Assembly>(evmVersion, false, std::string{});
+			auto subAsm = std::make_shared<Assembly>(evmVersion, false, std::nullopt, std::string{});
 			for (char i = 0; i < numImmutables; ++i)
 			{
 				for (int r = 0; r < numActualRefs; ++r)
@@ -256,7 +257,7 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 				}
 			}
 
-			Assembly assembly{evmVersion, true, {}};
+			Assembly assembly{evmVersion, true, std::nullopt, {}};
 			for (char i = 1; i <= numImmutables; ++i)
 			{
 				assembly.setSourceLocation({10*i, 10*i + 3+i, assemblyName});
@@ -299,6 +300,102 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(binary_source_mapping)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	auto assemblyName = std::make_shared<std::string>("root.asm");
+	std::map<std::string, unsigned> indices = {
+		{ *assemblyName, 0 }
+	};
+
+	Assembly assembly{evmVersion, false, std::nullopt, {}};
+	assembly.setSourceLocation({1, 3, assemblyName});
+	assembly.append(u256(1));
+	assembly.append(u256(2));
+	assembly.setSourceLocation({200, 210, assemblyName});
+	assembly.append(Instruction::ADD);
+	assembly.append(Instruction::POP);
+
+	BOOST_CHECK_EQUAL(
+		AssemblyItem::computeSourceMapping(assembly.items(), indices),
+		"1:2:0:-:0;;200:10;"
+	);
+	BOOST_CHECK_EQUAL(
+		util::toHex(AssemblyItem::computeBinarySourceMapping(assembly.items(), indices)),
+		"1f0203012d00" // all components of the first entry
+		"00"           // unchanged
+		"03c9010b"     // start (LEB128 of 201) and length (11)
+		"00"           // unchanged
+	);
+}
+
+BOOST_AUTO_TEST_CASE(compact_jump_tags)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	auto assembleWithJumps = [&](bool _compactJumpTags) {
+		Assembly assembly{evmVersion, false, std::nullopt, {}};
+		AssemblyItem early = assembly.newTag();
+		AssemblyItem late = assembly.newTag();
+		assembly.append(early);
+		assembly.append(early.pushTag());
+		assembly.append(Instruction::JUMP);
+		assembly.append(late.pushTag());
+		assembly.append(Instruction::JUMP);
+		for (size_t i = 0; i < 300; ++i)
+			assembly.append(Instruction::STOP);
+		assembly.append(late);
+
+		assembly.setCompactJumpTags(_compactJumpTags);
+		return assembly.assemble().toHex();
+	};
+
+	std::string stops(600, '0');
+	// All tags use the width required by the code size.
+	BOOST_CHECK_EQUAL(
+		assembleWithJumps(false),
+		"5b" "610000" "56" "610135" "56" + stops + "5b"
+	);
+	// The early tag fits into one byte, the late one needs two.
+	BOOST_CHECK_EQUAL(
+		assembleWithJumps(true),
+		"5b" "6000" "56" "610134" "56" + stops + "5b"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(eof_container)
+{
+	Assembly assembly{EVMVersion{}, false, 1, {}};
+	uint16_t function = assembly.createFunction(1, 1);
+
+	assembly.append(assembly.newData({0xaa, 0xbb}));
+	assembly.append(Instruction::POP);
+	assembly.append(u256(2));
+	assembly.appendFunctionCall(function);
+	assembly.append(Instruction::POP);
+	assembly.append(Instruction::STOP);
+
+	assembly.beginFunction(function);
+	AssemblyItem nonZero = assembly.newTag();
+	assembly.append(Instruction::DUP1);
+	assembly.appendConditionalRelativeJump(nonZero);
+	assembly.appendFunctionReturn();
+	assembly.append(nonZero);
+	assembly.setDeposit(1);
+	assembly.append(u256(3));
+	assembly.append(Instruction::ADD);
+	assembly.appendFunctionReturn();
+	assembly.endFunction();
+
+	BOOST_CHECK_EQUAL(
+		assembly.assemble().toHex(),
+		"ef0001" "010008" "020002" "000a" "0009" "030002" "00" // header
+		"00000001" "01010002"                                   // types: inputs, outputs, max stack height
+		"602c" "50" "6002" "e30001" "50" "00"                  // code section 0
+		"80" "e10001" "e4" "6003" "01" "e4"                    // code section 1
+		"aabb"                                                 // data section
+	);
+}
+
 BOOST_AUTO_TEST_CASE(immutable)
 {
 	std::map<std::string, unsigned> indices = {
@@ -306,11 +403,11 @@ BOOST_AUTO_TEST_CASE(immutable)
 		{ "sub.asm", 1 }
 	};
 	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
-	Assembly _assembly{evmVersion, true, {}};
+	Assembly _assembly{evmVersion, true, std::nullopt, {}};
 	auto root_asm = std::make_shared<std::string>("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
-	Assembly _subAsm{evmVersion, false, {}};
+	Assembly _subAsm{evmVersion, false, std::nullopt, {}};
 	auto sub_asm = std::make_shared<std::string>("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	_subAsm.appendImmutable("someImmutable");
@@ -404,10 +501,10 @@ BOOST_AUTO_TEST_CASE(immutable)
 BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 {
 	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
-	Assembly assembly{evmVersion, true, {}};
+	Assembly assembly{evmVersion, true, std::nullopt, {}};
 
-	std::shared_ptr<Assembly> subAsmPtr = std::make_shared<Assembly>(evmVersion, false, std::string{});
-	std::shared_ptr<Assembly> subSubAsmPtr = std::make_shared<Assembly>(evmVersion, false, std::string{});
+	std::shared_ptr<Assembly> subAsmPtr = std::make_shared<Assembly>(evmVersion, false, std::nullopt, std::string{});
+	std::shared_ptr<Assembly> subSubAsmPtr = std::make_shared<Assembly>(evmVersion, false, std::nullopt, std::string{});
 
 	assembly.appendSubroutine(subAsmPtr);
 	subAsmPtr->appendSubroutine(subSubAsmPtr);
@@ -27,6 +27,7 @@
 #include <libevmasm/PeepholeOptimiser.h>
 #include <libevmasm/Inliner.h>
 #include <libevmasm/JumpdestRemover.h>
+#include <libevmasm/JumpThreader.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/Assembly.h>
@@ -1259,8 +1260,8 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
 	settings.expectedExecutionsPerDeployment = OptimiserSettings{}.expectedExecutionsPerDeployment;
 
-	Assembly main{settings.evmVersion, false, {}};
-	AssemblyPointer sub = std::make_shared<Assembly>(settings.evmVersion, true, std::string{});
+	Assembly main{settings.evmVersion, false, std::nullopt, {}};
+	AssemblyPointer sub = std::make_shared<Assembly>(settings.evmVersion, true, std::nullopt, std::string{});
 
 	sub->append(u256(1));
 	auto t1 = sub->newTag();
@@ -1914,6 +1915,155 @@ BOOST_AUTO_TEST_CASE(inliner_invalid)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(jump_threader_forwarding_block)
+{
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		Instruction::STOP
+	};
+	BOOST_CHECK(JumpThreader{items, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}}.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(jump_threader_chain)
+{
+	// Tag 1 falls through to tag 2, which jumps on to tag 3.
+	AssemblyItems items{
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(Tag, 2),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::SSTORE,
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(Tag, 2),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::SSTORE,
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMPI,
+		Instruction::STOP
+	};
+	BOOST_CHECK(JumpThreader{items, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}}.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(jump_threader_cycle)
+{
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	AssemblyItems expectation = items;
+	BOOST_CHECK(!JumpThreader{items, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}}.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(jump_threader_tail_duplication)
+{
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::SWAP2,
+		Instruction::POP,
+		Instruction::POP,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::JUMP
+	};
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 1),
+		Instruction::SWAP2,
+		Instruction::POP,
+		Instruction::POP,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::SWAP2,
+		Instruction::POP,
+		Instruction::POP,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::JUMP
+	};
+
+	// Not worth it if the code is rarely executed.
+	AssemblyItems rarelyExecuted = items;
+	BOOST_CHECK(!JumpThreader{rarelyExecuted, 1, false, {}}.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		rarelyExecuted.begin(), rarelyExecuted.end(),
+		items.begin(), items.end()
+	);
+
+	BOOST_CHECK(JumpThreader{items, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}}.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
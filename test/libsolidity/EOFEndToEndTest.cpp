@@ -0,0 +1,238 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * End to end tests that compile contracts to EOF containers and execute them.
+ */
+
+#include <test/libsolidity/SolidityExecutionFramework.h>
+
+#include <test/Common.h>
+
+#include <libsolutil/ErrorCodes.h>
+#include <libsolutil/FunctionSelector.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::test;
+using namespace solidity::langutil;
+
+#define ALSO_OPTIMIZED(CODE)                                    \
+{                                                               \
+	m_optimiserSettings = OptimiserSettings::minimal();         \
+	{ CODE }                                                    \
+                                                                \
+	reset();                                                    \
+	m_optimiserSettings = OptimiserSettings::full();            \
+	{ CODE }                                                    \
+}
+
+namespace solidity::frontend::test
+{
+
+struct EOFEndToEndTestExecutionFramework: public SolidityExecutionFramework
+{
+	EOFEndToEndTestExecutionFramework():
+		SolidityExecutionFramework(EVMVersion{}, 1, CommonOptions::get().vmPaths)
+	{
+		m_compileViaYul = true;
+	}
+
+	struct CodeSectionType
+	{
+		uint8_t inputs;
+		uint8_t outputs;
+		uint16_t maxStackHeight;
+	};
+
+	/// @returns the entries of the type section of the runtime container of the last contract,
+	/// i.e. one entry per code section.
+	std::vector<CodeSectionType> runtimeCodeSectionTypes()
+	{
+		bytes const& container = m_compiler.runtimeObject(m_compiler.lastContractName()).bytecode;
+		auto readUint16 = [&](size_t _position) -> uint16_t {
+			BOOST_REQUIRE(_position + 2 <= container.size());
+			return static_cast<uint16_t>((container[_position] << 8) | container[_position + 1]);
+		};
+
+		// Magic, version, type section kind and size, code section kind and number of sections.
+		BOOST_REQUIRE(container.size() >= 10);
+		BOOST_REQUIRE(container[0] == 0xef && container[1] == 0x00 && container[2] == 0x01);
+		BOOST_REQUIRE(container[3] == 0x01);
+		uint16_t typeSectionSize = readUint16(4);
+		BOOST_REQUIRE(container[6] == 0x02);
+		uint16_t numCodeSections = readUint16(7);
+		BOOST_REQUIRE_EQUAL(typeSectionSize, 4 * numCodeSections);
+
+		// Code section sizes, data section kind and size, terminator.
+		size_t typeSectionStart = 9 + 2 * size_t(numCodeSections) + 3 + 1;
+		std::vector<CodeSectionType> types;
+		for (size_t i = 0; i < numCodeSections; ++i)
+		{
+			size_t position = typeSectionStart + 4 * i;
+			BOOST_REQUIRE(position + 4 <= container.size());
+			types.push_back({container[position], container[position + 1], readUint16(position + 2)});
+		}
+		return types;
+	}
+};
+
+BOOST_FIXTURE_TEST_SUITE(EOFEndToEndTest, EOFEndToEndTestExecutionFramework)
+
+BOOST_AUTO_TEST_CASE(function_code_sections)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function sumOfSquares(uint a, uint b) internal pure returns (uint) {
+				return square(a) + square(b);
+			}
+			function square(uint x) internal pure returns (uint) {
+				return x * x;
+			}
+			function fib(uint n) internal pure returns (uint) {
+				if (n < 2)
+					return n;
+				return fib(n - 1) + fib(n - 2);
+			}
+			function f(uint a, uint b) public pure returns (uint, uint) {
+				return (sumOfSquares(a, b), fib(a));
+			}
+		}
+	)";
+	ALSO_OPTIMIZED(
+		compileAndRun(sourceCode);
+		// The main code section takes no inputs and returns no outputs, the other sections are functions.
+		std::vector<CodeSectionType> types = runtimeCodeSectionTypes();
+		BOOST_REQUIRE(types.size() > 1);
+		BOOST_CHECK_EQUAL(types[0].inputs, 0);
+		BOOST_CHECK_EQUAL(types[0].outputs, 0);
+
+		ABI_CHECK(callContractFunction("f(uint256,uint256)", 3, 4), encodeArgs(25, 2));
+		ABI_CHECK(callContractFunction("f(uint256,uint256)", 10, 0), encodeArgs(100, 55));
+		// Checked arithmetic calls the non-returning panic function, which is followed by INVALID.
+		ABI_CHECK(callContractFunction("f(uint256,uint256)", u256(1) << 128, 0), panicData(PanicCode::UnderOverflow));
+	)
+}
+
+BOOST_AUTO_TEST_CASE(non_returning_functions)
+{
+	char const* sourceCode = R"(
+		contract C {
+			error TooLarge(uint value, uint limit);
+			function fail(uint value) internal pure {
+				revert TooLarge(value, 100);
+			}
+			function check(uint value) internal pure returns (uint) {
+				if (value > 100)
+					fail(value);
+				return value + 1;
+			}
+			function f(uint value) public pure returns (uint) {
+				return check(value) * 2;
+			}
+			function g() public pure {
+				fail(7);
+			}
+		}
+	)";
+	ALSO_OPTIMIZED(
+		compileAndRun(sourceCode);
+		ABI_CHECK(callContractFunction("f(uint256)", 5), encodeArgs(12));
+		ABI_CHECK(callContractFunction("f(uint256)", 100), encodeArgs(202));
+		ABI_CHECK(
+			callContractFunction("f(uint256)", 101),
+			util::selectorFromSignatureH32("TooLarge(uint256,uint256)").asBytes() + encode(101) + encode(100)
+		);
+		ABI_CHECK(
+			callContractFunction("g()"),
+			util::selectorFromSignatureH32("TooLarge(uint256,uint256)").asBytes() + encode(7) + encode(100)
+		);
+	)
+}
+
+BOOST_AUTO_TEST_CASE(cold_blocks_in_functions)
+{
+	char const* sourceCode = R"(
+		contract C {
+			mapping(uint => uint) balances;
+			function withdraw(uint account, uint amount) internal returns (uint) {
+				uint balance = balances[account];
+				require(balance >= amount, "Insufficient balance");
+				balances[account] = balance - amount;
+				return balance - amount;
+			}
+			function deposit(uint account, uint amount) public returns (uint) {
+				balances[account] += amount;
+				return balances[account];
+			}
+			function transfer(uint from, uint to, uint amount) public returns (uint, uint) {
+				uint remaining = withdraw(from, amount);
+				return (remaining, deposit(to, amount));
+			}
+		}
+	)";
+	ALSO_OPTIMIZED(
+		m_optimiserSettings.outlineColdBlocks = true;
+		compileAndRun(sourceCode);
+		ABI_CHECK(callContractFunction("deposit(uint256,uint256)", 1, 50), encodeArgs(50));
+		ABI_CHECK(callContractFunction("transfer(uint256,uint256,uint256)", 1, 2, 20), encodeArgs(30, 20));
+		ABI_CHECK(
+			callContractFunction("transfer(uint256,uint256,uint256)", 1, 2, 31),
+			util::selectorFromSignatureH32("Error(string)").asBytes() + encodeDyn(std::string("Insufficient balance"))
+		);
+		ABI_CHECK(callContractFunction("transfer(uint256,uint256,uint256)", 2, 1, 20), encodeArgs(0, 50));
+	)
+}
+
+BOOST_AUTO_TEST_CASE(max_stack_height)
+{
+	// Uses many stack slots within a single function and passes many arguments between functions.
+	char const* sourceCode = R"(
+		contract C {
+			function mix(uint a, uint b, uint c, uint d, uint e, uint f, uint g) internal pure returns (uint, uint, uint) {
+				uint h = a * b + c;
+				uint i = d * e + f;
+				uint j = g * h + i;
+				return (h + i + j, (a + b) * (c + d) + (e + f) * g, j - i);
+			}
+			function f(uint x) public pure returns (uint, uint, uint) {
+				(uint r, uint s, uint t) = mix(x, x + 1, x + 2, x + 3, x + 4, x + 5, x + 6);
+				(uint u, uint v, uint w) = mix(r % 7, s % 7, t % 7, 1, 2, 3, 4);
+				return (u, v, w);
+			}
+		}
+	)";
+	ALSO_OPTIMIZED(
+		// The container is only accepted if the declared maximum stack heights are exact.
+		compileAndRun(sourceCode);
+		for (CodeSectionType const& type: runtimeCodeSectionTypes())
+		{
+			BOOST_CHECK(type.maxStackHeight >= type.inputs);
+			BOOST_CHECK(type.maxStackHeight <= 1024);
+		}
+
+		// mix(1, 2, 3, 4, 5, 6, 7) = (5 + 26 + 61, 3 * 7 + 11 * 7, 35) = (92, 98, 35)
+		// mix(92 % 7, 98 % 7, 35 % 7, 1, 2, 3, 4) = mix(1, 0, 0, 1, 2, 3, 4) = (0 + 5 + 5, 1 + 20, 0) = (10, 21, 0)
+		ABI_CHECK(callContractFunction("f(uint256)", 1), encodeArgs(10, 21, 0));
+	)
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // end namespaces
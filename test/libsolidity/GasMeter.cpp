@@ -282,6 +282,16 @@ BOOST_AUTO_TEST_CASE(extcodesize_gas)
 	testRunTimeGas("f()", std::vector<bytes>{encodeArgs()});
 }
 
+BOOST_AUTO_TEST_CASE(eof_control_flow_gas)
+{
+	// RJUMP and RJUMPI as specified in EIP-4200, CALLF and RETF as specified in EIP-4750.
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	BOOST_CHECK_EQUAL(GasMeter::runGas(Instruction::RJUMP, evmVersion), 2u);
+	BOOST_CHECK_EQUAL(GasMeter::runGas(Instruction::RJUMPI, evmVersion), 4u);
+	BOOST_CHECK_EQUAL(GasMeter::runGas(Instruction::CALLF, evmVersion), 5u);
+	BOOST_CHECK_EQUAL(GasMeter::runGas(Instruction::RETF, evmVersion), 3u);
+}
+
 BOOST_AUTO_TEST_CASE(regular_functions_exclude_fallback)
 {
 	// A bug in the estimator caused the costs for a specific function
@@ -337,6 +347,32 @@ BOOST_AUTO_TEST_CASE(complex_control_flow)
 	testRunTimeGas("ln(int128)", std::vector<bytes>{encodeArgs(0), encodeArgs(10), encodeArgs(105), encodeArgs(30000)});
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_estimation_matches_individual_estimation)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint public x;
+			mapping(uint => uint) public m;
+			function f(uint a) public { x = a; }
+			function g(uint a, uint b) public { m[a] = b + x; }
+			function h() public view returns (bytes32) { return keccak256(abi.encodePacked(x)); }
+		}
+	)";
+	compile(sourceCode);
+	GasEstimator estimator(solidity::test::CommonOptions::get().evmVersion());
+	AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	std::vector<std::string> signatures{"x()", "m(uint256)", "f(uint256)", "g(uint256,uint256)", "h()", "INVALID"};
+
+	std::vector<GasMeter::GasConsumption> gas = estimator.functionalEstimations(items, signatures);
+	BOOST_REQUIRE_EQUAL(gas.size(), signatures.size());
+	for (size_t i = 0; i < signatures.size(); ++i)
+	{
+		GasMeter::GasConsumption expectation = estimator.functionalEstimation(items, signatures[i]);
+		BOOST_CHECK_EQUAL(gas[i].isInfinite, expectation.isInfinite);
+		BOOST_CHECK_EQUAL(gas[i].value, expectation.value);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
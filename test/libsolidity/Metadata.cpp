@@ -26,6 +26,7 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/TemporaryDirectory.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -339,6 +340,56 @@ BOOST_AUTO_TEST_CASE(metadata_relevant_sources_imports)
 	BOOST_CHECK(metadata["sources"].isMember("C"));
 }
 
+BOOST_AUTO_TEST_CASE(metadata_relevant_sources_import_cycle)
+{
+	CompilerStack compilerStack;
+	char const* sourceCodeA = R"(
+		pragma solidity >=0.0;
+		import "./B";
+		contract A {}
+	)";
+	char const* sourceCodeB = R"(
+		pragma solidity >=0.0;
+		import "./A";
+		contract B {}
+	)";
+	char const* sourceCodeC = R"(
+		pragma solidity >=0.0;
+		import "./A";
+		import "./B";
+		contract C is A, B {}
+	)";
+	char const* sourceCodeD = R"(
+		pragma solidity >=0.0;
+		contract D {}
+	)";
+	compilerStack.setSources({
+		{"A", sourceCodeA},
+		{"B", sourceCodeB},
+		{"C", sourceCodeC},
+		{"D", sourceCodeD}
+	});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+	std::map<std::string, std::set<std::string>> expectedSources{
+		{"A", {"A", "B"}},
+		{"B", {"A", "B"}},
+		{"C", {"A", "B", "C"}},
+		{"D", {"D"}}
+	};
+	for (auto const& [contractName, sources]: expectedSources)
+	{
+		Json::Value metadata;
+		BOOST_REQUIRE(util::jsonParseStrict(compilerStack.metadata(contractName), metadata));
+		BOOST_CHECK(solidity::test::isValidMetadata(metadata));
+		BOOST_CHECK_EQUAL(metadata["sources"].size(), sources.size());
+		for (std::string const& source: sources)
+			BOOST_CHECK(metadata["sources"].isMember(source));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(metadata_useLiteralContent)
 {
 	// Check that the metadata contains "useLiteralContent"
@@ -485,6 +536,44 @@ BOOST_AUTO_TEST_CASE(metadata_optimiser_sequence)
 		check(sequence, cleanupSequence);
 }
 
+BOOST_AUTO_TEST_CASE(metadata_isolated_function_optimization)
+{
+	char const* sourceCode = R"(
+		pragma solidity >=0.0;
+		contract C {
+			function f(uint x) public pure returns (uint) { return x + 1; }
+		}
+	)";
+
+	auto yulDetails = [sourceCode](bool _isolatedFunctionOptimization, std::string const& _cacheDirectory)
+	{
+		OptimiserSettings optimizerSettings = OptimiserSettings::full();
+		optimizerSettings.isolatedFunctionOptimization = _isolatedFunctionOptimization;
+		optimizerSettings.yulFunctionCacheDirectory = _cacheDirectory;
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"", sourceCode}});
+		compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compilerStack.setViaIR(true);
+		compilerStack.setOptimiserSettings(optimizerSettings);
+
+		BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+		Json::Value metadata;
+		BOOST_REQUIRE(util::jsonParseStrict(compilerStack.metadata("C"), metadata));
+		BOOST_CHECK(solidity::test::isValidMetadata(metadata));
+		return metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	};
+
+	BOOST_CHECK(!yulDetails(false, "").isMember("isolatedFunctionOptimization"));
+	BOOST_CHECK(yulDetails(true, "")["isolatedFunctionOptimization"].asBool());
+
+	// The cache directory does not affect the output and is not recorded.
+	util::TemporaryDirectory cacheDirectory("solidity-yul-function-cache");
+	Json::Value cached = yulDetails(true, cacheDirectory.path().string());
+	BOOST_CHECK_EQUAL(cached, yulDetails(true, ""));
+	BOOST_CHECK(cached["isolatedFunctionOptimization"].asBool());
+}
+
 BOOST_AUTO_TEST_CASE(metadata_license_missing)
 {
 	char const* sourceCode = R"(
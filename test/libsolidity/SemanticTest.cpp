@@ -107,6 +107,9 @@ SemanticTest::SemanticTest(
 	m_revertStrings = revertStrings.value();
 
 	m_allowNonExistingFunctions = m_reader.boolSetting("allowNonExistingFunctions", false);
+	m_packedStorageArrayCopy = m_reader.boolSetting("packedStorageArrayCopy", false);
+	m_largeLiteralsInData = m_reader.boolSetting("largeLiteralsInData", false);
+	m_isolatedFunctionOptimization = m_reader.boolSetting("isolatedFunctionOptimization", false);
 
 	parseExpectations(m_reader.stream());
 	soltestAssert(!m_tests.empty(), "No tests specified in " + _filename);
@@ -352,6 +355,9 @@ TestCase::TestResult SemanticTest::runTest(
 	reset();
 
 	m_compileViaYul = _isYulRun;
+	m_optimiserSettings.packedStorageArrayCopy = m_packedStorageArrayCopy;
+	m_optimiserSettings.largeLiteralsInData = m_largeLiteralsInData;
+	m_optimiserSettings.isolatedFunctionOptimization = m_isolatedFunctionOptimization;
 
 	if (_isYulRun)
 		AnsiColorized(_stream, _formatted, {BOLD, CYAN}) << _linePrefix << "Running via Yul: " << std::endl;
@@ -565,9 +571,14 @@ TestCase::TestResult SemanticTest::tryRunTestWithYulOptimizer(
 
 bool SemanticTest::checkGasCostExpectation(TestFunctionCall& io_test, bool _compileViaYul) const
 {
+	// Optimizer details enabled by the test itself do not change the name of the setting.
+	OptimiserSettings optimiserSettings = m_optimiserSettings;
+	optimiserSettings.packedStorageArrayCopy = false;
+	optimiserSettings.largeLiteralsInData = false;
+	optimiserSettings.isolatedFunctionOptimization = false;
 	std::string setting =
 		(_compileViaYul ? "ir"s : "legacy"s) +
-		(m_optimiserSettings == OptimiserSettings::full() ? "Optimized" : "");
+		(optimiserSettings == OptimiserSettings::full() ? "Optimized" : "");
 
 	// We don't check gas if enforce gas cost is not active
 	// or test is run with abi encoder v1 only
@@ -121,6 +121,12 @@ private:
 	bool m_testCaseWantsLegacyRun = true;
 	bool m_runWithABIEncoderV1Only = false;
 	bool m_allowNonExistingFunctions = false;
+	/// Enables the optimizer detail of the same name, which only affects the legacy code generator.
+	bool m_packedStorageArrayCopy = false;
+	/// Enables the optimizer detail of the same name, which only affects the IR code generator.
+	bool m_largeLiteralsInData = false;
+	/// Enables the Yul optimizer detail of the same name, which only has an effect if the Yul optimizer is run.
+	bool m_isolatedFunctionOptimization = false;
 	bool m_gasCostFailure = false;
 	bool m_enforceGasCost = false;
 	RequiresYulOptimizer m_requiresYulOptimizer{};
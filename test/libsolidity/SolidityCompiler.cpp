@@ -28,6 +28,49 @@
 namespace solidity::frontend::test
 {
 
+namespace
+{
+
+/// C is created by B and D, B is created by A. A and D are requested, so the artifacts of C can
+/// only be released once D has been compiled.
+char const* contractsWithDependencies = R"(
+	pragma abicoder v2;
+	contract C { function f(uint[] memory _x) public pure returns (uint) { return _x.length; } }
+	contract B { function g() public returns (address) { return address(new C()); } }
+	contract A { function f() public returns (address) { return address(new B()); } }
+	contract D { function h() public returns (address) { return address(new C()); } }
+)";
+
+std::unique_ptr<CompilerStack> compileWithRetainedArtifacts(
+	bool _viaIR,
+	CompilerStack::RetainedArtifacts const& _retainedArtifacts
+)
+{
+	auto compiler = std::make_unique<CompilerStack>();
+	compiler->setSources({{"A.sol", contractsWithDependencies}});
+	compiler->setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler->setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+	compiler->setViaIR(_viaIR);
+	compiler->enableIRGeneration();
+	compiler->setRequestedContractNames({{"A.sol", {"A", "D"}}});
+	compiler->setRetainedArtifacts(_retainedArtifacts);
+	BOOST_REQUIRE_MESSAGE(compiler->compile(), "Compiling contracts failed");
+	return compiler;
+}
+
+CompilerStack::RetainedArtifacts const noRetainedArtifacts{false, false, false, false, false, false};
+
+/// @returns the contracts that are assembled on their own. Via IR, this is only the case for
+/// the requested contracts, the others are only embedded as Yul objects.
+std::vector<std::string> assembledContracts(bool _viaIR)
+{
+	if (_viaIR)
+		return {"A", "D"};
+	return {"A", "B", "C", "D"};
+}
+
+}
+
 class SolidityCompilerFixture: protected AnalysisFramework
 {
 	void setupCompiler(CompilerStack& _compiler) override
@@ -68,6 +111,50 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(unretained_artifacts_are_released)
+{
+	for (bool viaIR: {false, true})
+	{
+		std::unique_ptr<CompilerStack> retaining = compileWithRetainedArtifacts(viaIR, {});
+		std::unique_ptr<CompilerStack> releasing = compileWithRetainedArtifacts(viaIR, noRetainedArtifacts);
+		for (std::string const name: {"A", "B", "C", "D"})
+		{
+			BOOST_CHECK(!retaining->yulIR(name).empty());
+			BOOST_CHECK(!retaining->yulIROptimized(name).empty());
+			BOOST_CHECK(!retaining->yulIRAst(name).isNull());
+			BOOST_CHECK(!retaining->yulIROptimizedAst(name).isNull());
+
+			BOOST_CHECK(releasing->yulIR(name).empty());
+			BOOST_CHECK(releasing->yulIROptimized(name).empty());
+			BOOST_CHECK(releasing->yulIRAst(name).isNull());
+			BOOST_CHECK(releasing->yulIROptimizedAst(name).isNull());
+			BOOST_CHECK(releasing->assemblyString(name).empty());
+			BOOST_CHECK(releasing->assemblyJSON(name).isNull());
+			BOOST_CHECK(releasing->generatedSources(name, true /* _runtime */).empty());
+		}
+		for (std::string const& name: assembledContracts(viaIR))
+			BOOST_CHECK(!retaining->assemblyString(name).empty());
+		// Only the legacy code generator produces utility code that ends up in the generated sources.
+		BOOST_CHECK_EQUAL(retaining->generatedSources("C", true /* _runtime */).empty(), viaIR);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(released_artifacts_of_dependencies)
+{
+	for (bool viaIR: {false, true})
+	{
+		std::unique_ptr<CompilerStack> retaining = compileWithRetainedArtifacts(viaIR, {});
+		std::unique_ptr<CompilerStack> releasing = compileWithRetainedArtifacts(viaIR, noRetainedArtifacts);
+		// The creation code of C is embedded in both B and D, so it has to be available until D is compiled.
+		for (std::string const& name: assembledContracts(viaIR))
+		{
+			BOOST_REQUIRE(!releasing->object(name).bytecode.empty());
+			BOOST_CHECK(releasing->object(name).bytecode == retaining->object(name).bytecode);
+			BOOST_CHECK(releasing->runtimeObject(name).bytecode == retaining->runtimeObject(name).bytecode);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -39,15 +39,17 @@ class SolidityExecutionFramework: public solidity::test::ExecutionFramework
 {
 
 public:
-	SolidityExecutionFramework(): m_showMetadata(solidity::test::CommonOptions::get().showMetadata) {}
+	SolidityExecutionFramework():
+		ExecutionFramework(solidity::test::CommonOptions::get().evmVersion(), solidity::test::CommonOptions::get().vmPaths),
+		m_showMetadata(solidity::test::CommonOptions::get().showMetadata)
+	{}
 	explicit SolidityExecutionFramework(
 		langutil::EVMVersion _evmVersion,
 		std::optional<uint8_t> _eofVersion,
 		std::vector<boost::filesystem::path> const& _vmPaths,
 		bool _appendCBORMetadata = true
 	):
-		ExecutionFramework(_evmVersion, _vmPaths),
-		m_eofVersion(_eofVersion),
+		ExecutionFramework(_evmVersion, _vmPaths, _eofVersion),
 		m_showMetadata(solidity::test::CommonOptions::get().showMetadata),
 		m_appendCBORMetadata(_appendCBORMetadata)
 	{}
@@ -81,7 +83,6 @@ public:
 
 protected:
 	using CompilerStack = solidity::frontend::CompilerStack;
-	std::optional<uint8_t> m_eofVersion;
 	CompilerStack m_compiler;
 	bool m_compileViaYul = false;
 	bool m_showMetadata = false;
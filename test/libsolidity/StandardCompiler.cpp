@@ -1744,6 +1744,62 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(large_literals_in_data)
+{
+	auto compile = [](bool _largeLiteralsInData) {
+		std::string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract C { function f(uint x) public pure returns (string memory) { require(x > 1, 'This revert reason is long enough to be stored in a data object.'); if (x > 2) return 'This revert reason is long enough to be stored in a data object.'; return 'short'; } }"
+				}
+			},
+			"settings": {
+				"viaIR": true,
+				"optimizer": {
+					"details": {
+						"largeLiteralsInData": )" + std::string(_largeLiteralsInData ? "true" : "false") + R"(
+					}
+				},
+				"outputSelection": {
+					"A.sol": {
+						"C": ["ir", "evm.deployedBytecode.object"]
+					}
+				}
+			}
+		}
+		)";
+
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+		solidity::frontend::StandardCompiler compiler;
+		Json::Value result = compiler.compile(parsedInput);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_REQUIRE(result["contracts"]["A.sol"]["C"]["ir"].isString());
+		BOOST_REQUIRE(!result["contracts"]["A.sol"]["C"]["evm"]["deployedBytecode"]["object"].asString().empty());
+		return result["contracts"]["A.sol"]["C"]["ir"].asString();
+	};
+
+	auto countOccurrences = [](std::string const& _haystack, std::string const& _needle) {
+		size_t count = 0;
+		for (size_t pos = _haystack.find(_needle); pos != std::string::npos; pos = _haystack.find(_needle, pos + 1))
+			++count;
+		return count;
+	};
+
+	std::string irCode = compile(true);
+	// Both uses of the long literal share one data object, the short literal is stored in the code.
+	BOOST_CHECK_EQUAL(countOccurrences(irCode, "data \"literal_"), 1);
+	BOOST_CHECK(irCode.find("datacopy(memPtr, dataoffset(\"literal_") != std::string::npos);
+	BOOST_CHECK(irCode.find("mstore(add(memPtr, 0), \"short\")") != std::string::npos);
+
+	irCode = compile(false);
+	BOOST_CHECK_EQUAL(countOccurrences(irCode, "data \"literal_"), 0);
+	BOOST_CHECK(irCode.find("datacopy(memPtr") == std::string::npos);
+}
+
 BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 {
 	char const* input = R"(
@@ -1781,6 +1837,47 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != std::string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(output_selection_retains_artifacts_of_dependencies)
+{
+	for (bool viaIR: {false, true})
+	{
+		std::string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract C { function f(uint[] memory _x) public pure returns (uint) { return _x.length; } } contract B { function g() public returns (address) { return address(new C()); } } contract A { function f() public returns (address) { return address(new B()); } }"
+				}
+			},
+			"settings": {
+				"viaIR": )" + std::string(viaIR ? "true" : "false") + R"(,
+				"outputSelection": {
+					"A.sol": {
+						"A": ["evm.bytecode.object"],
+						"C": ["irOptimized", "evm.assembly", "evm.deployedBytecode.generatedSources"]
+					}
+				}
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+
+		Json::Value contractA = getContractResult(result, "A.sol", "A");
+		BOOST_REQUIRE(contractA.isObject());
+		BOOST_CHECK(!contractA["evm"]["bytecode"]["object"].asString().empty());
+		BOOST_CHECK(!contractA.isMember("irOptimized"));
+
+		// C is released after B has been compiled, but its requested artifacts have to be kept.
+		Json::Value contractC = getContractResult(result, "A.sol", "C");
+		BOOST_REQUIRE(contractC.isObject());
+		BOOST_CHECK(!contractC["irOptimized"].asString().empty());
+		BOOST_CHECK(!contractC["evm"]["assembly"].asString().empty());
+		BOOST_REQUIRE(contractC["evm"]["deployedBytecode"]["generatedSources"].isArray());
+		BOOST_CHECK_EQUAL(contractC["evm"]["deployedBytecode"]["generatedSources"].empty(), viaIR);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,26 @@
+pragma abicoder v2;
+
+contract C {
+    uint8[] a;
+    bool[] b;
+    bytes2[] c;
+    function f(uint8[] calldata x) external returns (uint8[] memory) {
+        a = x;
+        return a;
+    }
+    function g(bool[] calldata x) external returns (bool[] memory) {
+        b = x;
+        return b;
+    }
+    function h(bytes2[] calldata x) external returns (bytes2[] memory) {
+        c = x;
+        return c;
+    }
+}
+// ====
+// compileViaYul: false
+// packedStorageArrayCopy: true
+// ----
+// f(uint8[]): 0x20, 3, 0x0101, 0x02, 0xff03 -> 0x20, 3, 1, 2, 3
+// g(bool[]): 0x20, 3, 0, 2, 0x0100 -> 0x20, 3, false, true, true
+// h(bytes2[]): 0x20, 2, 0x12340000000000000000000000000000000000000000000000000000000000ff, left(0x5678) -> 0x20, 2, left(0x1234), left(0x5678)
@@ -0,0 +1,28 @@
+contract C {
+    uint8[] a;
+    bytes2[] c;
+    function f() public returns (uint8[] memory) {
+        uint8[] memory x = new uint8[](3);
+        assembly {
+            mstore(add(x, 0x20), 0x0101)
+            mstore(add(x, 0x40), 0x02)
+            mstore(add(x, 0x60), 0xff03)
+        }
+        a = x;
+        return a;
+    }
+    function g() public returns (bytes2[] memory) {
+        bytes2[] memory x = new bytes2[](2);
+        assembly {
+            mstore(add(x, 0x20), 0x12340000000000000000000000000000000000000000000000000000000000ff)
+            mstore(add(x, 0x40), 0x5678000000000000000000000000000000000000000000000000000000000001)
+        }
+        c = x;
+        return c;
+    }
+}
+// ====
+// packedStorageArrayCopy: true
+// ----
+// f() -> 0x20, 3, 1, 2, 3
+// g() -> 0x20, 2, left(0x1234), left(0x5678)
@@ -0,0 +1,35 @@
+pragma abicoder v2;
+
+contract C {
+    uint64[] s;
+    function fromMemory(uint64[] memory x) public returns (uint64[] memory) {
+        s = x;
+        return s;
+    }
+    function fromCalldata(uint64[] calldata x) external returns (uint64[] memory) {
+        s = x;
+        return s;
+    }
+    function slot(uint i) public view returns (uint r) {
+        assembly {
+            mstore(0, s.slot)
+            r := sload(add(keccak256(0, 0x20), i))
+        }
+    }
+}
+// ====
+// packedStorageArrayCopy: true
+// ----
+// fromMemory(uint64[]): 0x20, 1, 7 -> 0x20, 1, 7
+// slot(uint256): 0 -> 7
+// fromMemory(uint64[]): 0x20, 6, 1, 2, 3, 4, 5, 6 -> 0x20, 6, 1, 2, 3, 4, 5, 6
+// slot(uint256): 0 -> 0x4000000000000000300000000000000020000000000000001
+// slot(uint256): 1 -> 0x60000000000000005
+// fromMemory(uint64[]): 0x20, 2, 8, 9 -> 0x20, 2, 8, 9
+// slot(uint256): 0 -> 0x90000000000000008
+// slot(uint256): 1 -> 0
+// fromCalldata(uint64[]): 0x20, 5, 1, 2, 3, 4, 5 -> 0x20, 5, 1, 2, 3, 4, 5
+// slot(uint256): 1 -> 5
+// fromMemory(uint64[]): 0x20, 0 -> 0x20, 0
+// slot(uint256): 0 -> 0
+// slot(uint256): 1 -> 0
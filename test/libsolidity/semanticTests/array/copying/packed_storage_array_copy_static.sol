@@ -0,0 +1,25 @@
+contract C {
+    bool[33] b;
+    bytes3[12] c;
+    function f(bool[33] memory x) public returns (bool, bool, bool, uint r0, uint r1) {
+        b = x;
+        assembly {
+            r0 := sload(b.slot)
+            r1 := sload(add(b.slot, 1))
+        }
+        return (b[0], b[31], b[32], r0, r1);
+    }
+    function g(bytes3[12] memory x) public returns (bytes3, bytes3, uint r0, uint r1) {
+        c = x;
+        assembly {
+            r0 := sload(c.slot)
+            r1 := sload(add(c.slot, 1))
+        }
+        return (c[9], c[11], r0, r1);
+    }
+}
+// ====
+// packedStorageArrayCopy: true
+// ----
+// f(bool[33]): true, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, true, true -> true, true, true, 0x0100000000000000000000000000000000000000000000000000000000000001, 1
+// g(bytes3[12]): left(0x010203), 0, 0, 0, 0, 0, 0, 0, 0, left(0x0a0b0c), 0, left(0x0d0e0f) -> left(0x0a0b0c), left(0x0d0e0f), 0xa0b0c000000000000000000000000000000000000000000000000010203, 0xd0e0f000000
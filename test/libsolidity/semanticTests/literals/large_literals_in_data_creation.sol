@@ -0,0 +1,25 @@
+contract D {
+    constructor() {
+        revert("Constructor revert reason that is long enough to be copied from data.");
+    }
+}
+contract C {
+    string public s;
+    constructor() {
+        string memory m = "This string literal is stored in the data section of the creation code.";
+        s = m;
+    }
+    function f() public returns (string memory) {
+        try new D() returns (D) {
+            return "";
+        } catch Error(string memory reason) {
+            return reason;
+        }
+    }
+}
+// ====
+// EVMVersion: >=byzantium
+// largeLiteralsInData: true
+// ----
+// s() -> 0x20, 0x47, "This string literal is stored in", " the data section of the creatio", "n code."
+// f() -> 0x20, 0x45, "Constructor revert reason that i", "s long enough to be copied from ", "data."
@@ -0,0 +1,19 @@
+contract C {
+    function r(bool fail) public pure {
+        require(!fail, "This revert reason is long enough to be copied from the data section.");
+    }
+    function s() public pure returns (string memory) {
+        return "This string literal is stored in the data section of the runtime code.";
+    }
+    function b() public pure returns (bytes memory x, bytes memory y) {
+        x = hex"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f2021222324252627";
+        y = hex"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9fa0a1a2a3a4a5a6a7";
+    }
+}
+// ====
+// largeLiteralsInData: true
+// ----
+// r(bool): false ->
+// r(bool): true -> FAILURE, hex"08c379a0", 0x20, 0x45, "This revert reason is long enoug", "h to be copied from the data sec", "tion."
+// s() -> 0x20, 0x46, "This string literal is stored in", " the data section of the runtime", " code."
+// b() -> 0x40, 0xa0, 0x28, 0x000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f, left(0x2021222324252627), 0x28, 0x808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f, left(0xa0a1a2a3a4a5a6a7)
@@ -0,0 +1,59 @@
+contract C {
+	function f(uint a) public pure returns (uint r, uint m) {
+		uint x1 = a + 1;
+		uint x2 = a + 2;
+		uint x3 = a + 3;
+		uint x4 = a + 4;
+		uint x5 = a + 5;
+		uint x6 = a + 6;
+		uint x7 = a + 7;
+		uint x8 = a + 8;
+		uint x9 = a + 9;
+		uint x10 = a + 10;
+		uint x11 = a + 11;
+		uint x12 = a + 12;
+		uint x13 = a + 13;
+		uint x14 = a + 14;
+		uint x15 = a + 15;
+		uint x16 = a + 16;
+		uint x17 = a + 17;
+		uint x18 = a + 18;
+		uint x19 = a + 19;
+		uint x20 = a + 20;
+		uint[] memory arr = new uint[](2);
+		arr[0] = 7;
+		arr[1] = 8;
+		r = x1 + x2 + x3 + x4 + x5 + x6 + x7 + x8 + x9 + x10;
+		r += x11 + x12 + x13 + x14 + x15 + x16 + x17 + x18 + x19 + x20;
+		m = arr[0] + arr[1];
+	}
+
+	function g(uint n) public pure returns (uint s) {
+		uint y1 = 1;
+		uint y2 = 2;
+		uint y3 = 3;
+		uint y4 = 4;
+		uint y5 = 5;
+		uint y6 = 6;
+		uint y7 = 7;
+		uint y8 = 8;
+		uint y9 = 9;
+		uint y10 = 10;
+		uint y11 = 11;
+		uint y12 = 12;
+		uint y13 = 13;
+		uint y14 = 14;
+		uint y15 = 15;
+		uint y16 = 16;
+		uint y17 = 17;
+		uint y18 = 18;
+		for (uint i = 0; i < n; ++i)
+			s += y1 + y18;
+		s += y1 + y2 + y3 + y4 + y5 + y6 + y7 + y8 + y9 + y10 + y11 + y12 + y13 + y14 + y15 + y16 + y17 + y18;
+	}
+}
+// ====
+// compileViaYul: false
+// ----
+// f(uint256): 1 -> 230, 15
+// g(uint256): 3 -> 228
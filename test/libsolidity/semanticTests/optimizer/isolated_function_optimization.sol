@@ -0,0 +1,32 @@
+contract C {
+    function fib(uint n) internal pure returns (uint a) {
+        uint b = 1;
+        for (uint i = 0; i < n; i++)
+            (a, b) = (b, a + b);
+    }
+    function sum(uint[] memory xs) internal pure returns (uint s) {
+        for (uint i = 0; i < xs.length; i++)
+            s += xs[i];
+    }
+    function f(uint n) public pure returns (uint) {
+        return fib(n);
+    }
+    function g(uint[] calldata xs) public pure returns (uint) {
+        return sum(xs);
+    }
+    function h(uint x) public pure returns (uint) {
+        return x * x;
+    }
+}
+// ====
+// isolatedFunctionOptimization: true
+// ----
+// f(uint256): 0 -> 0
+// f(uint256): 10 -> 55
+// f(uint256): 93 -> 12200160415121876738
+// f(uint256): 370 -> FAILURE, hex"4e487b71", 0x11
+// g(uint256[]): 0x20, 0 -> 0
+// g(uint256[]): 0x20, 3, 1, 2, 3 -> 6
+// g(uint256[]): 0x20, 2, -1, 1 -> FAILURE, hex"4e487b71", 0x11
+// h(uint256): 3 -> 9
+// h(uint256): 0x0100000000000000000000000000000000 -> FAILURE, hex"4e487b71", 0x11
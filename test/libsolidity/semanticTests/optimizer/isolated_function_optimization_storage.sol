@@ -0,0 +1,32 @@
+contract C {
+    mapping(uint => uint) public values;
+    uint public total;
+    event Set(uint indexed key, uint value);
+
+    constructor() {
+        update(1, 10);
+        update(2, 20);
+    }
+    function update(uint key, uint value) internal {
+        total = total - values[key] + value;
+        values[key] = value;
+    }
+    function set(uint key, uint value) public {
+        update(key, value);
+        emit Set(key, value);
+    }
+    function hash(bytes memory data) public pure returns (bytes32) {
+        return keccak256(data);
+    }
+}
+// ====
+// isolatedFunctionOptimization: true
+// ----
+// total() -> 30
+// values(uint256): 1 -> 10
+// values(uint256): 2 -> 20
+// set(uint256,uint256): 1, 5 ->
+// ~ emit Set(uint256,uint256): #0x01, 0x05
+// total() -> 25
+// values(uint256): 1 -> 5
+// hash(bytes): 0x20, 3, "abc" -> 0x4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45
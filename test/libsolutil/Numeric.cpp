@@ -0,0 +1,103 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the fixed-width arithmetic helpers in Numeric.h.
+ */
+
+#include <libsolutil/Numeric.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+std::vector<u256> const interestingValues{
+	0,
+	1,
+	2,
+	3,
+	0xff,
+	0x100,
+	u256(1) << 128,
+	(u256(1) << 255) - 1,
+	u256(1) << 255,
+	(u256(1) << 255) + 1,
+	~u256(0) - 1,
+	~u256(0)
+};
+
+bigint const wordModulus = bigint(1) << 256;
+
+}
+
+BOOST_AUTO_TEST_SUITE(NumericTest)
+
+BOOST_AUTO_TEST_CASE(signed_conversion)
+{
+	BOOST_CHECK_EQUAL(u2s(0), s256(0));
+	BOOST_CHECK_EQUAL(u2s(~u256(0)), s256(-1));
+	BOOST_CHECK_EQUAL(u2s(u256(1) << 255), -s256(u256(1) << 255));
+	BOOST_CHECK_EQUAL(s2u(s256(-1)), ~u256(0));
+	BOOST_CHECK_EQUAL(s2u(-s256(u256(1) << 255)), u256(1) << 255);
+
+	for (u256 const& value: interestingValues)
+	{
+		bigint reference = boost::multiprecision::bit_test(value, 255) ? bigint(value) - wordModulus : bigint(value);
+		BOOST_CHECK_EQUAL(bigint(u2s(value)), reference);
+		BOOST_CHECK_EQUAL(s2u(u2s(value)), value);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(modular_arithmetic)
+{
+	for (u256 const& a: interestingValues)
+		for (u256 const& b: interestingValues)
+			for (u256 const& modulus: interestingValues)
+			{
+				if (modulus == 0)
+					continue;
+				BOOST_CHECK_EQUAL(addmod256(a, b, modulus), u256((bigint(a) + bigint(b)) % bigint(modulus)));
+				BOOST_CHECK_EQUAL(mulmod256(a, b, modulus), u256((bigint(a) * bigint(b)) % bigint(modulus)));
+			}
+}
+
+BOOST_AUTO_TEST_CASE(exponentiation)
+{
+	for (u256 const& base: interestingValues)
+		for (u256 const& exponent: interestingValues)
+			BOOST_CHECK_EQUAL(
+				exp256(base, exponent),
+				u256(boost::multiprecision::powm(bigint(base), bigint(exponent), wordModulus))
+			);
+}
+
+BOOST_AUTO_TEST_CASE(shift_left_truncates)
+{
+	for (u256 const& value: interestingValues)
+		for (unsigned shift: {0u, 1u, 8u, 128u, 255u})
+			BOOST_CHECK_EQUAL(u256(value << shift), u256((bigint(value) << shift) % wordModulus));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
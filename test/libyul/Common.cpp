@@ -91,7 +91,8 @@ std::pair<std::shared_ptr<Object>, std::shared_ptr<yul::AsmAnalysisInfo>> yul::t
 yul::Block yul::test::disambiguate(std::string const& _source, bool _yul)
 {
 	auto result = parse(_source, _yul);
-	return std::get<Block>(Disambiguator(defaultDialect(_yul), *result.second, {})(*result.first));
+	Disambiguator(defaultDialect(_yul), *result.second, {}).disambiguateInPlace(*result.first);
+	return std::move(*result.first);
 }
 
 std::string yul::test::format(std::string const& _source, bool _yul)
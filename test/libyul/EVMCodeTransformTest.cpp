@@ -44,6 +44,8 @@ EVMCodeTransformTest::EVMCodeTransformTest(std::string const& _filename):
 {
 	m_source = m_reader.source();
 	m_stackOpt = m_reader.boolSetting("stackOptimization", false);
+	m_outlineColdBlocks = m_reader.boolSetting("outlineColdBlocks", false);
+	m_eliminateTailCalls = m_reader.boolSetting("eliminateTailCalls", false);
 	m_expectation = m_reader.simpleExpectations();
 }
 
@@ -67,14 +69,16 @@ TestCase::TestResult EVMCodeTransformTest::run(std::ostream& _stream, std::strin
 		return TestResult::FatalError;
 	}
 
-	evmasm::Assembly assembly{solidity::test::CommonOptions::get().evmVersion(), false, {}};
+	evmasm::Assembly assembly{solidity::test::CommonOptions::get().evmVersion(), false, std::nullopt, {}};
 	EthAssemblyAdapter adapter(assembly);
 	EVMObjectCompiler::compile(
 		*stack.parserResult(),
 		adapter,
 		EVMDialect::strictAssemblyForEVMObjects(EVMVersion{}),
 		m_stackOpt,
-		std::nullopt
+		std::nullopt,
+		m_outlineColdBlocks,
+		m_eliminateTailCalls
 	);
 
 	std::ostringstream output;
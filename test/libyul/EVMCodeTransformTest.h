@@ -34,6 +34,8 @@ public:
 	TestResult run(std::ostream& _stream, std::string const& _linePrefix = "", bool const _formatted = false) override;
 private:
 	bool m_stackOpt = false;
+	bool m_outlineColdBlocks = false;
+	bool m_eliminateTailCalls = false;
 };
 
 }
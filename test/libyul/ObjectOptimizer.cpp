@@ -0,0 +1,209 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for sharing optimized Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libyul/ObjectOptimizer.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::string optimize(
+	std::string const& _source,
+	std::shared_ptr<ObjectOptimizer> _objectOptimizer,
+	OptimiserSettings const& _settings = OptimiserSettings::full()
+)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		_settings,
+		DebugInfoSelection::All(),
+		std::move(_objectOptimizer)
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.optimize();
+	return stack.print();
+}
+
+std::string const innerObject = R"(
+	object "B" {
+		code {
+			function f(a) -> r { r := add(a, calldataload(a)) }
+			sstore(0, f(calldataload(0)))
+			return(0, datasize("B_deployed"))
+		}
+		object "B_deployed" {
+			code {
+				function g(x) -> y { y := mul(x, sload(x)) }
+				mstore(0, g(callvalue()))
+				return(0, 32)
+			}
+		}
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectOptimizer)
+
+BOOST_AUTO_TEST_CASE(reuse_identical_sub_object)
+{
+	std::string outerObject = R"(
+		object "A" {
+			code {
+				let size := datasize("B")
+				datacopy(0, dataoffset("B"), size)
+				sstore(0, create(0, 0, size))
+			}
+	)" + innerObject + "}";
+
+	auto sharedOptimizer = std::make_shared<ObjectOptimizer>();
+	std::string inner = optimize(innerObject, sharedOptimizer);
+	BOOST_CHECK_EQUAL(sharedOptimizer->reusedObjectCount(), 0);
+	std::string outer = optimize(outerObject, sharedOptimizer);
+	// The object "B" is reused together with its sub-object.
+	BOOST_CHECK_EQUAL(sharedOptimizer->reusedObjectCount(), 1);
+
+	BOOST_CHECK_EQUAL(outer, optimize(outerObject, nullptr));
+	BOOST_CHECK_EQUAL(inner, optimize(innerObject, nullptr));
+}
+
+BOOST_AUTO_TEST_CASE(no_reuse_with_different_settings)
+{
+	auto sharedOptimizer = std::make_shared<ObjectOptimizer>();
+	optimize(innerObject, sharedOptimizer);
+
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::minimal(),
+		DebugInfoSelection::All(),
+		sharedOptimizer
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", innerObject));
+	stack.optimize();
+	BOOST_CHECK_EQUAL(sharedOptimizer->reusedObjectCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(function_cache)
+{
+	TemporaryDirectory cacheDirectory("solidity-yul-function-cache");
+	OptimiserSettings settings = OptimiserSettings::full();
+	settings.isolatedFunctionOptimization = true;
+	settings.yulFunctionCacheDirectory = cacheDirectory.path().string();
+
+	auto coldOptimizer = std::make_shared<ObjectOptimizer>();
+	std::string cold = optimize(innerObject, coldOptimizer, settings);
+	BOOST_CHECK_EQUAL(coldOptimizer->reusedFunctionCount(), 0);
+
+	// A different object with the same functions under different names.
+	std::string renamedObject = R"(
+		object "C" {
+			code {
+				function h(b) -> s { s := add(b, calldataload(b)) }
+				sstore(1, h(calldataload(1)))
+			}
+		}
+	)";
+	auto warmOptimizer = std::make_shared<ObjectOptimizer>();
+	BOOST_CHECK_EQUAL(optimize(innerObject, warmOptimizer, settings), cold);
+	BOOST_CHECK_EQUAL(warmOptimizer->reusedFunctionCount(), 2);
+	std::string renamed = optimize(renamedObject, warmOptimizer, settings);
+	BOOST_CHECK_EQUAL(warmOptimizer->reusedFunctionCount(), 3);
+
+	// The output does not depend on the contents of the cache.
+	TemporaryDirectory emptyCacheDirectory("solidity-yul-function-cache");
+	settings.yulFunctionCacheDirectory = emptyCacheDirectory.path().string();
+	BOOST_CHECK_EQUAL(optimize(renamedObject, nullptr, settings), renamed);
+}
+
+BOOST_AUTO_TEST_CASE(function_cache_transparent)
+{
+	TemporaryDirectory cacheDirectory("solidity-yul-function-cache");
+	OptimiserSettings isolated = OptimiserSettings::full();
+	isolated.isolatedFunctionOptimization = true;
+	OptimiserSettings cached = isolated;
+	cached.yulFunctionCacheDirectory = cacheDirectory.path().string();
+
+	// The output only depends on the setting recorded in the metadata, not on the directory.
+	std::string withoutCache = optimize(innerObject, nullptr, isolated);
+	BOOST_CHECK_EQUAL(optimize(innerObject, nullptr, cached), withoutCache);
+	BOOST_CHECK_EQUAL(optimize(innerObject, nullptr, cached), withoutCache);
+}
+
+BOOST_AUTO_TEST_CASE(function_cache_source_locations)
+{
+	std::string source = R"(
+		/// @use-src 0:"a.sol"
+		object "C" {
+			code {
+				/// @src 0:0:100
+				function f(a) {
+					/// @src 0:10:20
+					sstore(a, 1)
+					/// @src 0:30:40
+					sstore(add(a, 1), 2)
+				}
+				/// @src 0:50:60
+				f(calldataload(0))
+				f(calldataload(32))
+			}
+		}
+	)";
+	TemporaryDirectory cacheDirectory("solidity-yul-function-cache");
+	OptimiserSettings settings = OptimiserSettings::full();
+	settings.isolatedFunctionOptimization = true;
+	settings.yulFunctionCacheDirectory = cacheDirectory.path().string();
+
+	// The statements keep their own source locations, also when taken from the cache.
+	for (size_t run = 0; run < 2; ++run)
+	{
+		std::string optimized = optimize(source, nullptr, settings);
+		BOOST_CHECK(optimized.find("@src 0:10:20") != std::string::npos);
+		BOOST_CHECK(optimized.find("@src 0:30:40") != std::string::npos);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -26,6 +26,7 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
+#include <libyul/optimiser/ConstantFunctionEvaluator.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 #include <libyul/optimiser/EqualStoreEliminator.h>
@@ -40,6 +41,7 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/Rematerialiser.h>
@@ -130,6 +132,10 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			disambiguate();
 			ConditionalSimplifier::run(*m_context, *m_ast);
 		}},
+		{"constantFunctionEvaluator", [&]() {
+			disambiguate();
+			ConstantFunctionEvaluator::run(*m_context, *m_ast);
+		}},
 		{"expressionSplitter", [&]() { ExpressionSplitter::run(*m_context, *m_ast); }},
 		{"expressionJoiner", [&]() {
 			disambiguate();
@@ -154,6 +160,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_object->code);
 			FunctionSpecializer::run(*m_context, *m_object->code);
 		}},
+		{"sharedFunctionSpecializer", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_object->code);
+			SharedFunctionSpecializer::run(*m_context, *m_object->code);
+		}},
 		{"expressionInliner", [&]() {
 			disambiguate();
 			ExpressionInliner::run(*m_context, *m_ast);
@@ -280,6 +291,12 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			LoopInvariantCodeMotion::run(*m_context, *m_ast);
 		}},
+		{"loopUnroller", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			FunctionHoister::run(*m_context, *m_ast);
+			LoopUnroller::run(*m_context, *m_ast);
+		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -443,7 +460,7 @@ std::shared_ptr<Block> YulOptimizerTestCommon::run()
 
 void YulOptimizerTestCommon::disambiguate()
 {
-	*m_object->code = std::get<Block>(Disambiguator(*m_dialect, *m_analysisInfo)(*m_object->code));
+	Disambiguator(*m_dialect, *m_analysisInfo).disambiguateInPlace(*m_object->code);
 	m_analysisInfo.reset();
 	updateContext();
 }
@@ -225,7 +225,7 @@ class JsonRpcProcess:
         self.trace('receive_message', json.dumps(json_object, indent=4, sort_keys=True))
         return json_object
 
-    def send_message(self, method_name: str, params: Optional[dict]) -> None:
+    def send_message(self, method_name: str, params: Optional[dict], request_id: Optional[int] = None) -> None:
         if self.process.stdin is None:
             return
         message = {
@@ -233,6 +233,8 @@ class JsonRpcProcess:
             'method': method_name,
             'params': params
         }
+        if request_id is not None:
+            message['id'] = request_id
         json_string = json.dumps(obj=message)
         rpc_message = f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
         self.trace(f'send_message ({method_name})', json.dumps(message, indent=4, sort_keys=True))
@@ -1871,6 +1873,28 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(reports[0]['uri'], f'{self.project_root_uri}/goto/lib.sol', "")
         self.expect_equal(len(reports[0]['diagnostics']), 0, "should not contain diagnostics")
 
+    def test_cancelled_request(self, solc: JsonRpcProcess) -> None:
+        """
+        A request that is cancelled before the server handles it is answered with an error.
+        """
+        self.setup_lsp(solc)
+        TEST_NAME = 'lib'
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, 'goto')
+
+        # The cancellation is read before the request itself is handled.
+        solc.send_notification('$/cancelRequest', {'id': 42})
+        solc.send_message(
+            'textDocument/hover',
+            {
+                'textDocument': {'uri': self.get_test_file_uri(TEST_NAME, 'goto')},
+                'position': {'line': 0, 'character': 0}
+            },
+            request_id=42
+        )
+        response = solc.receive_message()
+        self.expect_equal(response['id'], 42, "Response to the cancelled request")
+        self.expect_equal(response['error']['code'], -32800, "Request cancelled error code")
+
     def test_textDocument_didChange_at_eol(self, solc: JsonRpcProcess) -> None:
         """
         Append at one line and insert a new one below.
@@ -1929,6 +1953,75 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(report3['diagnostics']), 1, "one diagnostic")
         self.expect_diagnostic(report3['diagnostics'][0], 4126, 6, (1, 23))
 
+    def test_textDocument_didChange_updates_diagnostics_and_hover(self, solc: JsonRpcProcess) -> None:
+        """
+        Edits a file twice and expects the diagnostics and the hover result to reflect each edit.
+        """
+        self.setup_lsp(solc)
+        FILE_NAME = 'didChange_template'
+        FILE_URI = self.get_test_file_uri(FILE_NAME)
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': self.get_test_file_contents(FILE_NAME)
+            }
+        })
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 1, "one publish diagnostics notification")
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 0, "no diagnostics")
+
+        def replace_contract_body(state_variable_type: str, body: str) -> None:
+            function_line = f"    function f() public view returns ({state_variable_type}) {{ {body} }}\n"
+            solc.send_message('textDocument/didChange', {
+                'textDocument': { 'uri': FILE_URI },
+                'contentChanges': [
+                    {
+                        'range': {
+                            'start': { 'line': 5, 'character': 0 },
+                            'end': { 'line': 5, 'character': 0 }
+                        },
+                        'text': f"    {state_variable_type} counter;\n" + function_line
+                    }
+                ]
+            })
+
+        def hover_counter(character: int) -> str:
+            response = solc.call_method('textDocument/hover', {
+                'textDocument': { 'uri': FILE_URI },
+                'position': { 'line': 6, 'character': character }
+            })
+            return response['result']['contents']['value']
+
+        replace_contract_body('uint', 'uint unused; return counter;')
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 1, "one publish diagnostics notification")
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 1, "one diagnostic")
+        self.expect_diagnostic(published_diagnostics[0]['diagnostics'][0], 2072, 6, (46, 57))
+        self.expect_equal(hover_counter(66), "```solidity\nuint256\n```\n\n", "hover shows the type after the first edit")
+
+        # Remove the two lines again and insert different ones.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [
+                {
+                    'range': {
+                        'start': { 'line': 5, 'character': 0 },
+                        'end': { 'line': 7, 'character': 0 }
+                    },
+                    'text': ""
+                }
+            ]
+        })
+        self.wait_for_diagnostics(solc)
+        replace_contract_body('bool', 'bool other; return counter;')
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 1, "one publish diagnostics notification")
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 1, "one diagnostic")
+        self.expect_diagnostic(published_diagnostics[0]['diagnostics'][0], 2072, 6, (46, 56))
+        self.expect_equal(hover_counter(65), "```solidity\nbool\n```\n\n", "hover shows the type after the second edit")
+
     def test_textDocument_didChange_empty_file(self, solc: JsonRpcProcess) -> None:
         """
         Starts with an empty file and changes it to look like
@@ -278,6 +278,7 @@ test_suite* init_unit_test_suite(int /*argc*/, char* /*argv*/[])
 			for (auto suite: {
 				"ABIDecoderTest",
 				"ABIEncoderTest",
+				"EOFEndToEndTest",
 				"SolidityAuctionRegistrar",
 				"SolidityWallet",
 				"GasMeterTests",
@@ -196,7 +196,7 @@ void FuzzerUtil::testConstantOptimizer(string const& _input, bool _quiet)
 
 	for (bool isCreation: {false, true})
 	{
-		Assembly assembly{langutil::EVMVersion{}, isCreation, {}};
+		Assembly assembly{langutil::EVMVersion{}, isCreation, std::nullopt, {}};
 		for (u256 const& n: numbers)
 		{
 			if (!_quiet)
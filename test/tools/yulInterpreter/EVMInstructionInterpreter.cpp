@@ -445,6 +445,11 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::SWAP14:
 	case Instruction::SWAP15:
 	case Instruction::SWAP16:
+	// --------------- EOF only, not available as builtins ---------------
+	case Instruction::RJUMP:
+	case Instruction::RJUMPI:
+	case Instruction::CALLF:
+	case Instruction::RETF:
 	{
 		yulAssert(false, "");
 		return 0;
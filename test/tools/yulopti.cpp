@@ -172,7 +172,7 @@ public:
 
 	void disambiguate()
 	{
-		*m_ast = std::get<yul::Block>(Disambiguator(m_dialect, *m_analysisInfo)(*m_ast));
+		Disambiguator(m_dialect, *m_analysisInfo).disambiguateInPlace(*m_ast);
 		m_analysisInfo.reset();
 		m_nameDispenser.reset(*m_ast);
 	}